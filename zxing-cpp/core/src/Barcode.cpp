@@ -144,6 +144,12 @@ Result& Result::setReaderOptions(const ReaderOptions& opts)
 	return *this;
 }
 
+// for the readers that find inverted symbols themselves, see Reader::findsInverted()
+void SetIsInverted(Barcode& barcode, bool isInverted)
+{
+	barcode.setIsInverted(isInverted);
+}
+
 #ifdef ZXING_EXPERIMENTAL_API
 void Result::symbol(BitMatrix&& bits)
 {
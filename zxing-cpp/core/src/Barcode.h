@@ -37,6 +37,7 @@ namespace ZXing {
 
 class DecoderResult;
 class DetectorResult;
+struct ErrorCorrectionStats;
 class WriterOptions;
 class Result; // TODO: 3.0 replace deprected symbol name
 
@@ -57,6 +58,11 @@ class Result
 	friend Barcodes ReadBarcodes(const ImageView&, const ReaderOptions&);
 	friend Image WriteBarcodeToImage(const Barcode&, const WriterOptions&);
 	friend void IncrementLineCount(Barcode&);
+	friend void SetIsInverted(Barcode&, bool);
+	friend class LineScanReader;
+#ifdef ZXING_EXPERIMENTAL_API
+	friend Barcodes DecodeSymbols(const std::vector<ImageView>&, BarcodeFormat, const ReaderOptions&, std::vector<ErrorCorrectionStats>*);
+#endif
 
 public:
 	Result() = default;
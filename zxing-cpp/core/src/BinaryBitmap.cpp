@@ -6,7 +6,12 @@
 #include "BinaryBitmap.h"
 
 #include "BitMatrix.h"
+#include "Pattern.h"
+#include "ZXAlgorithms.h"
+#include "ZXConfig.h"
 
+#include <algorithm>
+#include <limits>
 #include <mutex>
 
 namespace ZXing {
@@ -57,6 +62,29 @@ const BitMatrix* BinaryBitmap::getBitMatrix() const
 	return _cache->matrix.get();
 }
 
+bool BinaryBitmap::getPatternLine(PointI p0, PointI p1, PatternRow& res) const
+{
+	auto bits = getBitMatrix();
+	if (!bits || !bits->isIn(p0) || !bits->isIn(p1))
+		return false;
+
+	ZX_THREAD_LOCAL std::vector<uint8_t> line;
+	line.clear();
+	ForEachPixelOnLine(p0, p1, [&](PointI p) { line.push_back(bits->get(p) * BitMatrix::SET_V); });
+	GetPatternRow(Range(line), res);
+
+	return true;
+}
+
+bool BinaryBitmap::getSubPixelPatternRow(int row, int rotation, PatternRow& res) const
+{
+	if (!getPatternRow(row, rotation, res))
+		return false;
+	for (auto& w : res)
+		w = narrow_cast<PatternType>(std::min(w << SUBPIXEL_BITS, int(std::numeric_limits<PatternType>::max())));
+	return true;
+}
+
 void BinaryBitmap::invert()
 {
 	if (_cache->matrix) {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "ImageView.h"
+#include "Point.h"
 
 #include <cstdint>
 #include <memory>
@@ -42,6 +43,16 @@ protected:
 
 	BitMatrix binarize(const uint8_t threshold) const;
 
+	// Calls f(p) for each pixel p on the line from p0 to p1 (both inclusive), one per pixel in the main direction.
+	template <typename F>
+	static void ForEachPixelOnLine(PointI p0, PointI p1, F&& f)
+	{
+		int n = maxAbsComponent(p1 - p0);
+		auto step = n ? bresenhamDirection(PointF(p1 - p0)) : PointF();
+		for (int i = 0; i <= n; ++i)
+			f(PointI(centered(p0) + i * step));
+	}
+
 public:
 	BinaryBitmap(const ImageView& buffer);
 	virtual ~BinaryBitmap();
@@ -54,6 +65,20 @@ public:
 	*/
 	virtual bool getPatternRow(int row, int rotation, PatternRow& res) const = 0;
 
+	/**
+	* Converts the image data along the line from p0 to p1 (both inclusive, inside the image) to a vector of ints denoting
+	* the widths of the bars and spaces, like getPatternRow() but at any angle. There is one sample per pixel in the main
+	* direction of the line. The default implementation samples the BitMatrix.
+	*/
+	virtual bool getPatternLine(PointI p0, PointI p1, PatternRow& res) const;
+
+	/**
+	* Like getPatternRow() but the widths are fixed-point numbers with SUBPIXEL_BITS fractional bits (see Pattern.h). The
+	* default implementation only scales the result of getPatternRow(), GlobalHistogramBinarizer locates the edges between
+	* the bars and spaces with sub-pixel precision in the luminance data.
+	*/
+	virtual bool getSubPixelPatternRow(int row, int rotation, PatternRow& res) const;
+
 	const BitMatrix* getBitMatrix() const;
 
 	void invert();
@@ -108,13 +108,14 @@ T& AppendBit(T& val, bool bit)
 }
 
 template <typename ARRAY, typename = std::enable_if_t<std::is_integral_v<typename ARRAY::value_type>>>
-int ToInt(const ARRAY& a)
+constexpr int ToInt(const ARRAY& a)
 {
-	assert(Reduce(a) <= 32);
-
-	int pattern = 0;
-	for (int i = 0; i < Size(a); i++)
+	int pattern = 0, sum = 0;
+	for (int i = 0; i < Size(a); i++) {
 		pattern = (pattern << a[i]) | ~(0xffffffff << a[i]) * (~i & 1);
+		sum += a[i];
+	}
+	assert(sum <= 32);
 	return pattern;
 }
 
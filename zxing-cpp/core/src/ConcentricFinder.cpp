@@ -8,6 +8,7 @@
 #include "LogMatrix.h"
 #include "RegressionLine.h"
 #include "ZXAlgorithms.h"
+#include "ZXConfig.h"
 
 namespace ZXing {
 
@@ -116,20 +117,24 @@ std::optional<PointF> CenterOfRings(const BitMatrix& image, PointF center, int r
 	return sum / n;
 }
 
-static std::vector<PointF> CollectRingPoints(const BitMatrix& image, PointF center, int range, int edgeIndex, bool backup)
+// collects the points along the edgeIndex-th edge around center into points (reusing its capacity) and returns false
+// if the edge is not a closed loop around center
+static bool CollectRingPoints(const BitMatrix& image, PointF center, int range, int edgeIndex, bool backup,
+							  std::vector<PointF>& points)
 {
+	points.clear();
 	PointI centerI(center);
 	int radius = range;
 	BitMatrixCursorI cur(image, centerI, {0, 1});
 	if (!cur.stepToEdge(edgeIndex, radius, backup))
-		return {};
+		return false;
 	cur.turnRight(); // move clock wise and keep edge on the right/left depending on backup
 	const auto edgeDir = backup ? Direction::LEFT : Direction::RIGHT;
 
 	uint32_t neighbourMask = 0;
 	auto start = cur.p;
-	std::vector<PointF> points;
-	points.reserve(4 * range);
+	const int maxPoints = 4 * 2 * range;
+	points.reserve(maxPoints + 1); // no-op once the buffer has grown large enough
 
 	do {
 		log(cur.p, 4);
@@ -139,23 +144,21 @@ static std::vector<PointF> CollectRingPoints(const BitMatrix& image, PointF cent
 		neighbourMask |= (1 << (4 + dot(bresenhamDirection(cur.p - centerI), PointI(1, 3))));
 
 		if (!cur.stepAlongEdge(edgeDir))
-			return {};
+			return false;
 
 		// use L-inf norm, simply because it is a lot faster than L2-norm and sufficiently accurate
-		if (maxAbsComponent(cur.p - centerI) > radius || centerI == cur.p || Size(points) > 4 * 2 * range)
-			return {};
+		if (maxAbsComponent(cur.p - centerI) > radius || centerI == cur.p || Size(points) > maxPoints)
+			return false;
 
 	} while (cur.p != start);
 
-	if (neighbourMask != 0b111101111)
-		return {};
-
-	return points;
+	return neighbourMask == 0b111101111;
 }
 
 static std::optional<QuadrilateralF> FitQadrilateralToPoints(PointF center, std::vector<PointF>& points)
 {
-	auto dist2Center = [c = center](auto a, auto b) { return distance(a, c) < distance(b, c); };
+	// comparing the squared distances is equivalent and saves the sqrt
+	auto dist2Center = [c = center](auto a, auto b) { return dot(a - c, a - c) < dot(b - c, b - c); };
 	// rotate points such that the first one is the furthest away from the center (hence, a corner)
 	std::rotate(points.begin(), std::max_element(points.begin(), points.end(), dist2Center), points.end());
 
@@ -209,8 +212,14 @@ static bool QuadrilateralIsPlausibleSquare(const QuadrilateralF q, int lineIndex
 
 static std::optional<QuadrilateralF> FitSquareToPoints(const BitMatrix& image, PointF center, int range, int lineIndex, bool backup)
 {
-	auto points = CollectRingPoints(image, center, range, lineIndex, backup);
-	if (points.empty())
+	// this is called for every finder pattern candidate, reuse the buffer to not hit the allocator every time
+	ZX_THREAD_LOCAL std::vector<PointF> points;
+	if (!CollectRingPoints(image, center, range, lineIndex, backup, points))
+		return {};
+
+	// a plausible square (see QuadrilateralIsPlausibleSquare) has a side length of at least 2 * lineIndex, so the ring
+	// has to consist of at least 4 * that many points. Allow some slack for the corners being extrapolated.
+	if (Size(points) < std::max(8, 6 * (lineIndex - backup)))
 		return {};
 
 	auto res = FitQadrilateralToPoints(center, points);
@@ -10,6 +10,7 @@
 #include "Quadrilateral.h"
 #include "ZXAlgorithms.h"
 
+#include <mutex>
 #include <optional>
 
 namespace ZXing {
@@ -106,6 +107,36 @@ std::optional<QuadrilateralF> FindConcentricPatternCorners(const BitMatrix& imag
 struct ConcentricPattern : public PointF
 {
 	int size = 0;
+	bool isInverted = false; // found in the inverted image, see DualPolarityBitMatrix
+};
+
+/**
+ * A BitMatrix together with its inverted copy, which is only created once it is asked for. This allows the finder
+ * pattern detectors to look for symbols of both polarities in a single pass over the image (see ReaderOptions::tryInvert)
+ * and to sample each of them in the image of its own polarity.
+ */
+class DualPolarityBitMatrix
+{
+	const BitMatrix& _image;
+	mutable BitMatrix _inverted;
+	mutable std::once_flag _invertedOnce; // the finder pattern search may run in parallel
+	bool _tryInverted;
+
+public:
+	DualPolarityBitMatrix(const BitMatrix& image, bool tryInverted) : _image(image), _tryInverted(tryInverted) {}
+
+	bool tryInverted() const { return _tryInverted; }
+
+	const BitMatrix& operator()(bool inverted) const
+	{
+		if (!inverted)
+			return _image;
+		std::call_once(_invertedOnce, [this] {
+			_inverted = _image.copy();
+			_inverted.flipAll();
+		});
+		return _inverted;
+	}
 };
 
 template <bool E2E = false, typename PATTERN>
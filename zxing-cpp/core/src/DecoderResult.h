@@ -25,6 +25,8 @@ class DecoderResult
 	int _lineCount = 0;
 	int _versionNumber = 0;
 	int _dataMask = 0;
+	int _ecCodewords = 0;
+	int _errorsCorrected = 0;
 	StructuredAppendInfo _structuredAppend;
 	bool _isMirrored = false;
 	bool _readerInit = false;
@@ -73,6 +75,8 @@ public:
 	ZX_PROPERTY(int, lineCount, setLineCount)
 	ZX_PROPERTY(int, versionNumber, setVersionNumber)
 	ZX_PROPERTY(int, dataMask, setDataMask)
+	ZX_PROPERTY(int, ecCodewords, setEcCodewords)         // number of error correction codewords
+	ZX_PROPERTY(int, errorsCorrected, setErrorsCorrected) // number of codewords fixed by the error correction
 	ZX_PROPERTY(StructuredAppendInfo, structuredAppend, setStructuredAppend)
 	ZX_PROPERTY(Error, error, setError)
 	ZX_PROPERTY(bool, isMirrored, setIsMirrored)
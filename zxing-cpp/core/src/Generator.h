@@ -23,8 +23,68 @@ namespace std {
 #include <coroutine>
 #endif
 
-#include <optional>
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <new>
+#include <optional>
+#include <utility>
+
+// Every call of a generator function heap allocates its coroutine frame. Detectors typically create the same few generators
+// for every image, so keep a small per-thread free list of frames around to recycle them instead of hitting the allocator.
+class CoroutineFramePool
+{
+	struct Frame
+	{
+		Frame* next;
+		std::size_t size;
+	};
+
+	struct Cache
+	{
+		Frame* head = nullptr;
+		int count = 0;
+
+		~Cache()
+		{
+			while (head)
+				::operator delete(std::exchange(head, head->next));
+		}
+	};
+
+	static constexpr int MAX_CACHED_FRAMES = 8;
+
+	// always thread_local instead of ZX_THREAD_LOCAL: 'static' would share the free list between threads and '' (nothing)
+	// would destroy it at the end of every call (coroutines need C++20, which has thread_local anyway)
+	static Cache& cache()
+	{
+		thread_local Cache cache;
+		return cache;
+	}
+
+public:
+	static void* allocate(std::size_t size)
+	{
+		auto& c = cache();
+		for (Frame** f = &c.head; *f; f = &(*f)->next)
+			if ((*f)->size == size) {
+				--c.count;
+				return std::exchange(*f, (*f)->next);
+			}
+		return ::operator new(std::max(size, sizeof(Frame)));
+	}
+
+	static void deallocate(void* p, std::size_t size) noexcept
+	{
+		auto& c = cache();
+		if (size >= sizeof(Frame) && c.count < MAX_CACHED_FRAMES) {
+			c.head = new (p) Frame{c.head, size};
+			++c.count;
+		} else {
+			::operator delete(p);
+		}
+	}
+};
 
 // this code is based on https://en.cppreference.com/w/cpp/coroutine/coroutine_handle#Example
 // but modified trying to prevent accidental copying of generated objects
@@ -53,6 +113,9 @@ public:
 		void await_transform() = delete;
 		[[noreturn]] static void unhandled_exception() { throw; }
 
+		static void* operator new(std::size_t size) { return CoroutineFramePool::allocate(size); }
+		static void operator delete(void* p, std::size_t size) noexcept { CoroutineFramePool::deallocate(p, size); }
+
 		std::optional<T> current_value;
 	};
 
@@ -110,6 +173,73 @@ private:
 	Handle _coroutine;
 };
 
+#else // no coroutine support
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Fallback for compilers without coroutine support: the generator is constructed from a callable that returns the next
+// value as a std::optional<T> (or std::nullopt when done), i.e. the 'coroutine' is a hand written state machine.
+// Iteration via range-based for loop works the same as with the coroutine based implementation above.
+template <class T>
+class Generator
+{
+	struct Source
+	{
+		virtual ~Source() = default;
+		virtual std::optional<T> next() = 0;
+	};
+
+	template <typename F>
+	struct SourceImpl : public Source
+	{
+		F f;
+		explicit SourceImpl(F&& f) : f(std::move(f)) {}
+		std::optional<T> next() override { return f(); }
+	};
+
+	std::unique_ptr<Source> _source;
+	std::optional<T> _current;
+
+	void advance() { _current = _source ? _source->next() : std::nullopt; }
+
+public:
+	Generator() = default;
+
+	template <typename F>
+	explicit Generator(F f) : _source(std::make_unique<SourceImpl<F>>(std::move(f)))
+	{}
+
+	Generator(const Generator&) = delete;
+	Generator& operator=(const Generator&) = delete;
+	Generator(Generator&&) noexcept = default;
+
+	struct Sentinel {};
+
+	// Range-based for loop support.
+	class Iter
+	{
+	public:
+		void operator++() { _gen->advance(); }
+		T&& operator*() const { return std::move(*_gen->_current); }
+		bool operator==(Sentinel) const { return !_gen->_current; }
+		bool operator!=(Sentinel) const { return _gen->_current.has_value(); }
+
+		explicit Iter(Generator* gen) : _gen{gen} {}
+
+	private:
+		Generator* _gen;
+	};
+
+	Iter begin()
+	{
+		advance();
+		return Iter{this};
+	}
+	Sentinel end() { return {}; }
+};
+
 #endif
 
 /*
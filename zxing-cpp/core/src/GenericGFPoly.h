@@ -83,6 +83,18 @@ public:
 		*this = other;
 	}
 
+	/**
+	 * @brief set the coefficients (most significant first), reusing the memory already allocated
+	 */
+	GenericGFPoly& setCoefficients(const std::vector<int>& coefficients)
+	{
+		assert(!coefficients.empty());
+		_coefficients.resize(coefficients.size());
+		std::copy(coefficients.begin(), coefficients.end(), _coefficients.begin());
+		normalize();
+		return *this;
+	}
+
 	GenericGFPoly& setField(const GenericGF& field)
 	{
 		_field = &field;
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <utility>
 
 namespace ZXing {
@@ -103,6 +104,24 @@ static int EstimateBlackPoint(const Histogram& buckets)
 	return bestValley << LUMINANCE_SHIFT;
 }
 
+// the common part of getPatternRow() and getPatternLine()
+static bool ThresholdLine(const ImageLineView lineView, PatternRow& res)
+{
+	auto threshold = EstimateBlackPoint(GenHistogram(lineView)) - 1;
+	if (threshold <= 0)
+		return false;
+
+	ZX_THREAD_LOCAL std::vector<uint8_t> binarized;
+	// the optimizer can generate a specialized version for pixStride==1 (non-rotated input) that is about 8x faster on AVX2 hardware
+	if (lineView.begin().stride == 1)
+		ThresholdSharpened(lineView, threshold, binarized);
+	else
+		ThresholdSharpened(lineView, threshold, binarized);
+	GetPatternRow(Range(binarized), res);
+
+	return true;
+}
+
 bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow& res) const
 {
 	auto buffer = _buffer.rotated(rotation);
@@ -124,21 +143,61 @@ bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow&
 	}
 #endif
 
-	auto threshold = EstimateBlackPoint(GenHistogram(lineView)) - 1;
-	if (threshold <= 0)
-		return false;
+	return ThresholdLine(lineView, res);
+}
 
-	ZX_THREAD_LOCAL std::vector<uint8_t> binarized;
-	// the optimizer can generate a specialized version for pixStride==1 (non-rotated input) that is about 8x faster on AVX2 hardware
-	if (lineView.begin().stride == 1)
-		ThresholdSharpened(lineView, threshold, binarized);
-	else
-		ThresholdSharpened(lineView, threshold, binarized);
-	GetPatternRow(Range(binarized), res);
+// Moves the edges between the bars and spaces of res, the pattern of line, to the sub-pixel position of the steepest
+// luminance gradient and converts the widths to fixed-point numbers, see SUBPIXEL_BITS. The position is the extremum of
+// the parabola through the gradient at the edge (between two pixels) and the ones at its neighbors, if that is a peak.
+static void RefineEdges(const ImageLineView line, PatternRow& res)
+{
+	constexpr int ONE = 1 << SUBPIXEL_BITS;
+	const int n = Size(line);
+	auto pix = [&line, n](int x) { return int(line.begin()[std::clamp(x, 0, n - 1)]); };
+	auto gradient = [&pix](int edge) { return pix(edge) - pix(edge - 1); };
+
+	int edge = 0, prev = 0;
+	for (int i = 0; i < Size(res); ++i) {
+		if (res[i] == 0)
+			continue; // the first/last space may be empty
+		edge += res[i];
+		int pos = edge * ONE;
+		if (edge < n) {
+			// the luminance falls from a space (even i) to a bar and rises from a bar to a space
+			int sign = i % 2 ? 1 : -1;
+			int g0 = sign * gradient(edge - 1), g1 = sign * gradient(edge), g2 = sign * gradient(edge + 1);
+			if (int curvature = g0 - 2 * g1 + g2; g1 > 0 && curvature < 0)
+				pos += std::clamp((g0 - g2) * ONE / (2 * curvature), -ONE / 2, ONE / 2);
+		}
+		// keep the order of the edges and a minimal width of 1
+		pos = std::max(pos, prev + 1);
+		res[i] = narrow_cast<PatternType>(std::min(pos - prev, int(std::numeric_limits<PatternType>::max())));
+		prev = pos;
+	}
+}
 
+bool GlobalHistogramBinarizer::getSubPixelPatternRow(int row, int rotation, PatternRow& res) const
+{
+	if (!getPatternRow(row, rotation, res))
+		return false;
+
+	RefineEdges(RowView(_buffer.rotated(rotation), row), res);
 	return true;
 }
 
+bool GlobalHistogramBinarizer::getPatternLine(PointI p0, PointI p1, PatternRow& res) const
+{
+	auto isIn = [this](PointI p) { return 0 <= p.x && p.x < width() && 0 <= p.y && p.y < height(); };
+	if (!isIn(p0) || !isIn(p1) || maxAbsComponent(p1 - p0) < 2)
+		return false;
+
+	ZX_THREAD_LOCAL std::vector<uint8_t> line;
+	line.clear();
+	ForEachPixelOnLine(p0, p1, [&](PointI p) { line.push_back(*(_buffer.data(p.x, p.y) + GreenIndex(_buffer.format()))); });
+
+	return ThresholdLine({{line.data(), 1}, {line.data() + line.size(), 1}}, res);
+}
+
 // Does not sharpen the data, as this call is intended to only be used by 2D Readers.
 std::shared_ptr<const BitMatrix>
 GlobalHistogramBinarizer::getBlackMatrix() const
@@ -28,6 +28,8 @@ public:
 	~GlobalHistogramBinarizer() override;
 
 	bool getPatternRow(int row, int rotation, PatternRow &res) const override;
+	bool getPatternLine(PointI p0, PointI p1, PatternRow& res) const override;
+	bool getSubPixelPatternRow(int row, int rotation, PatternRow& res) const override;
 	std::shared_ptr<const BitMatrix> getBlackMatrix() const override;
 };
 
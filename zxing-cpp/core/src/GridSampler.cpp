@@ -7,6 +7,9 @@
 
 #include "GridSampler.h"
 
+#include <algorithm>
+#include <array>
+
 #ifdef PRINT_DEBUG
 #include "LogMatrix.h"
 #include "BitMatrixIO.h"
@@ -34,38 +37,45 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const R
 		return {};
 
 	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
-		// Precheck the corners of every roi to bail out early if the grid is "obviously" not completely inside the image
+		// Check the corners of every roi to bail out if the grid is not completely inside the image. Due to a "numerical
+		// instability" in the PerspectiveTransform generation it has been observed that even though all boundary grid
+		// points get projected inside the image, an inner grid point was not. See #563. That can only happen if the
+		// transformation is not a true perspective transformation on the roi, i.e. the projective denominator changes
+		// its sign. Excluding that (see isRegularOn) proves all inner points are inside as well, at least in exact
+		// arithmetic. Rounding can still move a point that is close to the border outside, hence the clamping below.
 		auto isInside = [&mod2Pix = mod2Pix, &image](int x, int y) { return image.isIn(mod2Pix(centered(PointI(x, y)))); };
-		if (!mod2Pix.isValid() || !isInside(x0, y0) || !isInside(x1 - 1, y0) || !isInside(x1 - 1, y1 - 1) || !isInside(x0, y1 - 1))
+		if (!mod2Pix.isValid() || !mod2Pix.isRegularOn(Rectangle(x0, x1 - 1, y0, y1 - 1)) || !isInside(x0, y0)
+			|| !isInside(x1 - 1, y0) || !isInside(x1 - 1, y1 - 1) || !isInside(x0, y1 - 1))
 			return {};
 	}
 
+	// the modules of a row are projected in chunks of N, see PerspectiveTransform::operator()(p, d, n, x, y)
+	constexpr int N = 16;
+	std::array<PointF::value_t, N> xs, ys;
+
+	const int maxX = image.width() - 1, maxY = image.height() - 1;
 	BitMatrix res(width, height);
 	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
 		for (int y = y0; y < y1; ++y)
-			for (int x = x0; x < x1; ++x) {
-				auto p = mod2Pix(centered(PointI{x, y}));
-				// Due to a "numerical instability" in the PerspectiveTransform generation/application it has been observed
-				// that even though all boundary grid points get projected inside the image, it can still happen that an
-				// inner grid points is not. See #563. A true perspective transformation cannot have this property.
-				// The following check takes 100% care of the issue and turned out to be less of a performance impact than feared.
-				// TODO: Check some mathematical/numercial property of mod2Pix to determine if it is a perspective transforation.
-				if (!image.isIn(p))
-					return {};
-
+			for (int x = x0; x < x1; x += N) {
+				int n = std::min(N, x1 - x);
+				mod2Pix(centered(PointI{x, y}), {1, 0}, n, xs.data(), ys.data());
+				for (int i = 0; i < n; ++i) {
+					auto p = PointF(xs[i], ys[i]);
 #ifdef PRINT_DEBUG
-				log(p, 3);
+					log(p, 3);
 #endif
 #if 0
-				int sum = 0;
-				for (int dy = -1; dy <= 1; ++dy)
-					for (int dx = -1; dx <= 1; ++dx)
-						sum += image.get(p + PointF(dx, dy));
-				if (sum >= 5)
+					int sum = 0;
+					for (int dy = -1; dy <= 1; ++dy)
+						for (int dx = -1; dx <= 1; ++dx)
+							sum += image.get(p + PointF(dx, dy));
+					if (sum >= 5)
 #else
-				if (image.get(p))
+					if (image.get(std::clamp(int(p.x), 0, maxX), std::clamp(int(p.y), 0, maxY)))
 #endif
-					res.set(x, y);
+						res.set(x + i, y);
+				}
 			}
 	}
 
@@ -9,12 +9,26 @@
 #include "BarcodeFormat.h"
 #include "BinaryBitmap.h"
 #include "ReaderOptions.h"
+
+// Symbologies can be excluded from the build via the ZXING_FORMATS cmake option
+#ifndef ZXING_DISABLE_LINEAR
+#include "oned/ODReader.h"
+#endif
+#ifndef ZXING_DISABLE_AZTEC
 #include "aztec/AZReader.h"
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
 #include "datamatrix/DMReader.h"
+#endif
+#ifndef ZXING_DISABLE_MAXICODE
 #include "maxicode/MCReader.h"
-#include "oned/ODReader.h"
+#endif
+#ifndef ZXING_DISABLE_PDF417
 #include "pdf417/PDFReader.h"
+#endif
+#ifndef ZXING_DISABLE_QRCODE
 #include "qrcode/QRReader.h"
+#endif
 
 #include <memory>
 
@@ -24,24 +38,38 @@ MultiFormatReader::MultiFormatReader(const ReaderOptions& opts) : _opts(opts)
 {
 	auto formats = opts.formats().empty() ? BarcodeFormat::Any : opts.formats();
 
+#ifndef ZXING_DISABLE_LINEAR
 	// Put linear readers upfront in "normal" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && !opts.tryHarder())
 		_readers.emplace_back(new OneD::Reader(opts));
+#endif
 
+#ifndef ZXING_DISABLE_QRCODE
 	if (formats.testFlags(BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode))
 		_readers.emplace_back(new QRCode::Reader(opts, true));
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
 	if (formats.testFlag(BarcodeFormat::DataMatrix))
 		_readers.emplace_back(new DataMatrix::Reader(opts, true));
+#endif
+#ifndef ZXING_DISABLE_AZTEC
 	if (formats.testFlag(BarcodeFormat::Aztec))
 		_readers.emplace_back(new Aztec::Reader(opts, true));
+#endif
+#ifndef ZXING_DISABLE_PDF417
 	if (formats.testFlag(BarcodeFormat::PDF417))
 		_readers.emplace_back(new Pdf417::Reader(opts));
+#endif
+#ifndef ZXING_DISABLE_MAXICODE
 	if (formats.testFlag(BarcodeFormat::MaxiCode))
 		_readers.emplace_back(new MaxiCode::Reader(opts));
+#endif
 
+#ifndef ZXING_DISABLE_LINEAR
 	// At end in "try harder" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && opts.tryHarder())
 		_readers.emplace_back(new OneD::Reader(opts));
+#endif
 }
 
 MultiFormatReader::~MultiFormatReader() = default;
@@ -62,7 +90,7 @@ Barcodes MultiFormatReader::readMultiple(const BinaryBitmap& image, int maxSymbo
 	Barcodes res;
 
 	for (const auto& reader : _readers) {
-		if (image.inverted() && !reader->supportsInversion)
+		if (image.inverted() && (!reader->supportsInversion || reader->findsInverted()))
 			continue;
 		auto r = reader->decode(image, maxSymbols);
 		if (!_opts.returnErrors()) {
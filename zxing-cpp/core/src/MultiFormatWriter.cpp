@@ -6,42 +6,69 @@
 #include "MultiFormatWriter.h"
 
 #include "BitMatrix.h"
+
+// Symbologies can be excluded from the build via the ZXING_FORMATS cmake option
+#ifndef ZXING_DISABLE_AZTEC
 #include "aztec/AZWriter.h"
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
 #include "datamatrix/DMWriter.h"
+#endif
+#ifndef ZXING_DISABLE_CODABAR
 #include "oned/ODCodabarWriter.h"
+#endif
+#ifndef ZXING_DISABLE_CODE128
 #include "oned/ODCode128Writer.h"
+#endif
+#ifndef ZXING_DISABLE_CODE39
 #include "oned/ODCode39Writer.h"
+#endif
+#ifndef ZXING_DISABLE_CODE93
 #include "oned/ODCode93Writer.h"
+#endif
+#ifndef ZXING_DISABLE_EANUPC
 #include "oned/ODEAN13Writer.h"
 #include "oned/ODEAN8Writer.h"
-#include "oned/ODITFWriter.h"
 #include "oned/ODUPCAWriter.h"
 #include "oned/ODUPCEWriter.h"
+#endif
+#ifndef ZXING_DISABLE_ITF
+#include "oned/ODITFWriter.h"
+#endif
+#ifndef ZXING_DISABLE_PDF417
 #include "pdf417/PDFWriter.h"
+#endif
+#ifndef ZXING_DISABLE_QRCODE
 #include "qrcode/QRErrorCorrectionLevel.h"
 #include "qrcode/QRWriter.h"
-#include "Utf.h"
+#endif
 
 #include <stdexcept>
 
 namespace ZXing {
 
-BitMatrix
-MultiFormatWriter::encode(const std::wstring& contents, int width, int height) const
+template <typename STRING>
+BitMatrix MultiFormatWriter::encodeContents(const STRING& contents, int width, int height) const
 {
-	auto exec0 = [&](auto&& writer) {
+	[[maybe_unused]] auto exec0 = [&](auto&& writer) {
 		if (_margin >=0)
 			writer.setMargin(_margin);
 		return writer.encode(contents, width, height);
 	};
 
+#ifndef ZXING_DISABLE_AZTEC
 	auto AztecEccLevel = [&](Aztec::Writer& writer, int eccLevel) { writer.setEccPercent(eccLevel * 100 / 8); };
+#endif
+#ifndef ZXING_DISABLE_PDF417
 	auto Pdf417EccLevel = [&](Pdf417::Writer& writer, int eccLevel) { writer.setErrorCorrectionLevel(eccLevel); };
+#endif
+#ifndef ZXING_DISABLE_QRCODE
 	auto QRCodeEccLevel = [&](QRCode::Writer& writer, int eccLevel) {
 		writer.setErrorCorrectionLevel(static_cast<QRCode::ErrorCorrectionLevel>(--eccLevel / 2));
 	};
+#endif
 
-	auto exec1 = [&](auto&& writer, auto setEccLevel) {
+	[[maybe_unused]] auto exec1 = [&](auto&& writer, auto setEccLevel) {
 		if (_encoding != CharacterSet::Unknown)
 			writer.setEncoding(_encoding);
 		if (_eccLevel >= 0 && _eccLevel <= 8)
@@ -49,33 +76,58 @@ MultiFormatWriter::encode(const std::wstring& contents, int width, int height) c
 		return exec0(std::move(writer));
 	};
 
-	auto exec2 = [&](auto&& writer) {
+	[[maybe_unused]] auto exec2 = [&](auto&& writer) {
 		if (_encoding != CharacterSet::Unknown)
 			writer.setEncoding(_encoding);
 		return exec0(std::move(writer));
 	};
 
 	switch (_format) {
+#ifndef ZXING_DISABLE_AZTEC
 	case BarcodeFormat::Aztec: return exec1(Aztec::Writer(), AztecEccLevel);
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
 	case BarcodeFormat::DataMatrix: return exec2(DataMatrix::Writer());
+#endif
+#ifndef ZXING_DISABLE_PDF417
 	case BarcodeFormat::PDF417: return exec1(Pdf417::Writer(), Pdf417EccLevel);
-	case BarcodeFormat::QRCode: return exec1(QRCode::Writer(), QRCodeEccLevel);
+#endif
+#ifndef ZXING_DISABLE_QRCODE
+	case BarcodeFormat::QRCode: return exec1(QRCode::Writer().setCompact(_compact), QRCodeEccLevel);
+#endif
+#ifndef ZXING_DISABLE_CODABAR
 	case BarcodeFormat::Codabar: return exec0(OneD::CodabarWriter());
+#endif
+#ifndef ZXING_DISABLE_CODE39
 	case BarcodeFormat::Code39: return exec0(OneD::Code39Writer());
+#endif
+#ifndef ZXING_DISABLE_CODE93
 	case BarcodeFormat::Code93: return exec0(OneD::Code93Writer());
+#endif
+#ifndef ZXING_DISABLE_CODE128
 	case BarcodeFormat::Code128: return exec0(OneD::Code128Writer());
+#endif
+#ifndef ZXING_DISABLE_EANUPC
 	case BarcodeFormat::EAN8: return exec0(OneD::EAN8Writer());
 	case BarcodeFormat::EAN13: return exec0(OneD::EAN13Writer());
-	case BarcodeFormat::ITF: return exec0(OneD::ITFWriter());
 	case BarcodeFormat::UPCA: return exec0(OneD::UPCAWriter());
 	case BarcodeFormat::UPCE: return exec0(OneD::UPCEWriter());
+#endif
+#ifndef ZXING_DISABLE_ITF
+	case BarcodeFormat::ITF: return exec0(OneD::ITFWriter());
+#endif
 	default: throw std::invalid_argument(std::string("Unsupported format: ") + ToString(_format));
 	}
 }
 
+BitMatrix MultiFormatWriter::encode(const std::wstring& contents, int width, int height) const
+{
+	return encodeContents(contents, width, height);
+}
+
 BitMatrix MultiFormatWriter::encode(const std::string& contents, int width, int height) const
 {
-	return encode(FromUtf8(contents), width, height);
+	return encodeContents(contents, width, height);
 }
 
 } // ZXing
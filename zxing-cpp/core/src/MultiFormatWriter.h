@@ -41,6 +41,15 @@ public:
 		return *this;
 	}
 
+	/**
+	* Used for QRCode only, encode the content with the least number of bits by switching between the Numeric,
+	* Alphanumeric, Byte and Kanji modes.
+	*/
+	MultiFormatWriter& setCompact(bool compact) {
+		_compact = compact;
+		return *this;
+	}
+
 	/**
 	* Used for all formats, sets the minimum number of quiet zone pixels.
 	*/
@@ -53,10 +62,14 @@ public:
 	BitMatrix encode(const std::string& contents, int width, int height) const;
 
 private:
+	template <typename STRING>
+	BitMatrix encodeContents(const STRING& contents, int width, int height) const;
+
 	BarcodeFormat _format;
 	CharacterSet _encoding = CharacterSet::Unknown;
 	int _margin = -1;
 	int _eccLevel = -1;
+	bool _compact = false;
 };
 
 } // ZXing
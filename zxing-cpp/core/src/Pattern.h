@@ -14,6 +14,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <vector>
 
@@ -23,6 +24,10 @@ using PatternType = uint16_t;
 template<int N> using Pattern = std::array<PatternType, N>;
 using PatternRow = std::vector<PatternType>;
 
+// Number of fractional bits of the widths in a PatternRow returned by BinaryBitmap::getSubPixelPatternRow(). They are
+// fixed-point numbers, i.e. a width of 1 << SUBPIXEL_BITS is one pixel.
+constexpr int SUBPIXEL_BITS = 3;
+
 class PatternView
 {
 	using Iterator = PatternRow::const_pointer;
@@ -63,8 +68,8 @@ public:
 
 	// index is the number of bars and spaces from the first bar to the current position
 	int index() const { return narrow_cast<int>(_data - _base) - 1; }
-	int pixelsInFront() const { return Reduce(_base, _data); }
-	int pixelsTillEnd() const { return Reduce(_base, _data + _size) - 1; }
+	int pixelsInFront() const { return Reduce(_base, _data, 0); }
+	int pixelsTillEnd() const { return Reduce(_base, _data + _size, 0) - 1; }
 	bool isAtFirstBar() const { return _data == _base + 1; }
 	bool isAtLastBar() const { return _data + _size == _end - 1; }
 	bool isValid(int n) const { return _data && _data >= _base && _data + n <= _end; }
@@ -118,6 +123,16 @@ public:
 	{
 		_size = std::max(0, narrow_cast<int>(_end - _data));
 	}
+
+	// Returns a view on the whole row this view is part of as seen from its end, i.e. in reverse order. The reversed
+	// PatternRow is stored in buffer. A pixel position x in one of the two rows is at rowWidth() - x - 1 in the other.
+	PatternView reversedRow(PatternRow& buffer) const
+	{
+		buffer.assign(std::make_reverse_iterator(_end), std::make_reverse_iterator(_base));
+		return buffer;
+	}
+
+	int rowWidth() const { return Reduce(_base, _end, 0); }
 };
 
 /**
@@ -339,6 +354,63 @@ std::array<int, LEN> NormalizedPattern(const PatternView& view)
 	return is;
 }
 
+/**
+ * @brief PatternIndex is a perfect hash table, generated at compile time, that maps the key (e.g. ToInt()) of a
+ * normalized pattern to its index in a table of N known patterns. This replaces a linear IndexOf() search with a
+ * multiplication, a shift and one comparison.
+ */
+template <int N>
+class PatternIndex
+{
+	static constexpr int BITS = [] {
+		int bits = 4; // use at least 16 slots per key to make finding a collision free multiplier cheap
+		while ((1 << bits) < 16 * N)
+			++bits;
+		return bits;
+	}();
+	static_assert(N < 255 && BITS < 32, "PatternIndex supports at most 254 patterns");
+
+	std::array<int, N> _keys = {};
+	std::array<uint8_t, 1 << BITS> _slots = {}; // 1 + index into _keys, 0 means empty
+	uint32_t _mul = 0;
+
+	static constexpr int Hash(int key, uint32_t mul) noexcept { return static_cast<int>((static_cast<uint32_t>(key) * mul) >> (32 - BITS)); }
+
+public:
+	template <typename TABLE, typename KEY_FN>
+	constexpr PatternIndex(const TABLE& table, KEY_FN key)
+	{
+		for (int i = 0; i < N; ++i)
+			_keys[i] = key(table[i]);
+
+		// search for an odd multiplier that maps all keys to different slots
+		uint32_t mul = 0x9e3779b9;
+		for (int attempt = 0; attempt < 1000 && !_mul; ++attempt, mul = mul * 1664525 + 1013904223) {
+			for (auto& s : _slots)
+				s = 0;
+			int i = 0;
+			for (; i < N && !_slots[Hash(_keys[i], mul | 1)]; ++i)
+				_slots[Hash(_keys[i], mul | 1)] = static_cast<uint8_t>(i + 1);
+			if (i == N)
+				_mul = mul | 1;
+		}
+	}
+
+	template <typename TABLE>
+	constexpr explicit PatternIndex(const TABLE& keys) : PatternIndex(keys, [](int key) { return key; })
+	{}
+
+	/// false if the keys are not unique (or no perfect hash could be found)
+	constexpr bool isValid() const noexcept { return _mul != 0; }
+
+	/// @return the index of key in the table or -1 if it is not in there
+	constexpr int indexOf(int key) const noexcept
+	{
+		int i = _slots[Hash(key, _mul)] - 1;
+		return i >= 0 && _keys[i] == key ? i : -1;
+	}
+};
+
 template<typename I>
 void GetPatternRow(Range<I> b_row, PatternRow& p_row)
 {
@@ -7,6 +7,7 @@
 
 #include "PerspectiveTransform.h"
 
+#include <algorithm>
 #include <array>
 
 namespace ZXing {
@@ -78,4 +79,24 @@ PointF PerspectiveTransform::operator()(PointF p) const
 	return {(a11 * p.x + a21 * p.y + a31) / denominator, (a12 * p.x + a22 * p.y + a32) / denominator};
 }
 
+void PerspectiveTransform::operator()(PointF p, PointF d, int n, value_t* x, value_t* y) const
+{
+	// homogeneous coordinates of p and their increments per step d
+	value_t u0 = a11 * p.x + a21 * p.y + a31, du = a11 * d.x + a21 * d.y;
+	value_t v0 = a12 * p.x + a22 * p.y + a32, dv = a12 * d.x + a22 * d.y;
+	value_t w0 = a13 * p.x + a23 * p.y + a33, dw = a13 * d.x + a23 * d.y;
+	for (int i = 0; i < n; ++i) {
+		auto w = w0 + i * dw;
+		x[i] = (u0 + i * du) / w;
+		y[i] = (v0 + i * dv) / w;
+	}
+}
+
+bool PerspectiveTransform::isRegularOn(const QuadrilateralF& q) const
+{
+	auto denominator = [this](PointF p) { return a13 * p.x + a23 * p.y + a33; };
+	auto d0 = denominator(q[0]);
+	return std::all_of(q.begin(), q.end(), [&](PointF p) { return denominator(p) * d0 > 0; });
+}
+
 } // ZXing
@@ -39,6 +39,20 @@ public:
 	/// Project from the destination space (grid of modules) into the image space (bit matrix)
 	PointF operator()(PointF p) const;
 
+	/**
+	 * Project the n equidistant points p, p + d, ..., p + (n-1) * d into the arrays x and y. The homogeneous
+	 * coordinates are affine in the step index, so each point costs 3 multiply-adds and 2 divisions (no
+	 * dependency between the points means the loop gets vectorized).
+	 */
+	void operator()(PointF p, PointF d, int n, value_t* x, value_t* y) const;
+
+	/**
+	 * Check if the projective denominator has the same sign at all 4 corners of the convex quadrilateral q.
+	 * Since it is linear, it then has no zero inside q, i.e. the transformation is a proper perspective
+	 * transformation on q and maps every point inside q into the convex hull of its projected corners.
+	 */
+	bool isRegularOn(const QuadrilateralF& q) const;
+
 	bool isValid() const { return !std::isnan(a33); }
 };
 
@@ -15,8 +15,23 @@
 #include "MultiFormatReader.h"
 #include "Pattern.h"
 #include "ThresholdBinarizer.h"
+#if defined(ZXING_EXPERIMENTAL_API) && !defined(ZXING_DISABLE_LINEAR)
+#include "oned/ODReader.h"
+#endif
+#ifdef ZXING_EXPERIMENTAL_API
+#include "DecoderResult.h"
+#include "DetectorResult.h"
+#include "ZXThreads.h"
+#ifndef ZXING_DISABLE_DATAMATRIX
+#include "datamatrix/DMDecoder.h"
+#endif
+#ifndef ZXING_DISABLE_QRCODE
+#include "qrcode/QRDecoder.h"
+#endif
+#endif
 #endif
 
+#include <algorithm>
 #include <climits>
 #include <memory>
 #include <stdexcept>
@@ -188,7 +203,8 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 						r.setPosition(Scale(r.position(), _iv.width() / iv.width()));
 					if (!Contains(res, r)) {
 						r.setReaderOptions(opts);
-						r.setIsInverted(bitmap->inverted());
+						if (bitmap->inverted())
+							r.setIsInverted(true);
 						res.push_back(std::move(r));
 						--maxSymbols;
 					}
@@ -216,4 +232,141 @@ Barcodes ReadBarcodes(const ImageView&, const ReaderOptions&)
 
 #endif // ZXING_READERS
 
+#ifdef ZXING_EXPERIMENTAL_API
+#if defined(ZXING_READERS) && !defined(ZXING_DISABLE_LINEAR)
+
+struct LineScanReader::Data
+{
+	ReaderOptions opts;
+	OneD::RowStreamReader stream;
+	int rowCount = 0;
+	LumImage lum;
+	PatternRow bars;
+
+	Data(const ReaderOptions& opts, int maxHistory) : opts(opts), stream(this->opts, maxHistory) {}
+};
+
+LineScanReader::LineScanReader(const ReaderOptions& options, int maxHistory) : d(std::make_unique<Data>(options, maxHistory)) {}
+
+Barcodes LineScanReader::addRows(const ImageView& _iv)
+{
+	if (sizeof(PatternType) < 4 && _iv.width() > 0xffff)
+		throw std::invalid_argument("Maximum image width is 65535");
+
+	if (!_iv.data() || _iv.width() * _iv.height() == 0)
+		throw std::invalid_argument("ImageView is null/empty");
+
+	ImageView iv = SetupLumImageView(_iv, d->lum, d->opts);
+	auto bitmap = CreateBitmap(d->opts.binarizer(), iv);
+
+	Barcodes res;
+	for (int y = 0; y < iv.height(); ++y, ++d->rowCount) {
+		if (!bitmap->getPatternRow(y, 0, d->bars))
+			continue;
+		for (auto& r : d->stream.decodeRow(d->rowCount, d->bars))
+			res.push_back(std::move(r.setReaderOptions(d->opts)));
+	}
+	return res;
+}
+
+void LineScanReader::reset()
+{
+	d->stream.reset();
+	d->rowCount = 0;
+}
+
+#else
+
+struct LineScanReader::Data
+{
+	int rowCount = 0;
+	Data(const ReaderOptions&, int) {}
+};
+
+LineScanReader::LineScanReader(const ReaderOptions& options, int maxHistory) : d(std::make_unique<Data>(options, maxHistory)) {}
+
+Barcodes LineScanReader::addRows(const ImageView&)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading linear barcodes.");
+}
+
+void LineScanReader::reset() {}
+
+#endif
+
+LineScanReader::~LineScanReader() = default;
+LineScanReader::LineScanReader(LineScanReader&&) = default;
+LineScanReader& LineScanReader::operator=(LineScanReader&&) = default;
+
+int LineScanReader::rowCount() const
+{
+	return d->rowCount;
+}
+
+#ifdef ZXING_READERS
+
+using SymbolDecoder = DecoderResult (*)(const BitMatrix&);
+
+static SymbolDecoder SymbolDecoderFor(BarcodeFormat format)
+{
+	switch (format) {
+#ifndef ZXING_DISABLE_QRCODE
+	case BarcodeFormat::QRCode:
+	case BarcodeFormat::MicroQRCode:
+	case BarcodeFormat::RMQRCode: return QRCode::Decode;
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
+	case BarcodeFormat::DataMatrix: return DataMatrix::Decode;
+#endif
+	default: throw std::invalid_argument("DecodeSymbols supports only QRCode, MicroQRCode, RMQRCode and DataMatrix");
+	}
+}
+
+Barcodes DecodeSymbols(const std::vector<ImageView>& symbols, BarcodeFormat format, const ReaderOptions& opts,
+					   std::vector<ErrorCorrectionStats>* stats)
+{
+	auto decoder = SymbolDecoderFor(format);
+	for (auto& iv : symbols)
+		if (!iv.data() || iv.width() * iv.height() == 0 || iv.format() == ImageFormat::None)
+			throw std::invalid_argument("ImageView is null/empty");
+
+	Barcodes res(symbols.size());
+	if (stats)
+		stats->assign(symbols.size(), {});
+
+	auto decode = [&](int i) {
+		BitMatrix bits = ThresholdBinarizer(symbols[i], 127).getBitMatrix()->copy();
+		auto symbolFormat = format == BarcodeFormat::DataMatrix   ? format
+							: bits.width() != bits.height() ? BarcodeFormat::RMQRCode
+							: bits.width() < 21             ? BarcodeFormat::MicroQRCode
+															: BarcodeFormat::QRCode;
+		auto decoderResult = decoder(bits);
+		if (stats)
+			(*stats)[i] = {decoderResult.ecCodewords(), decoderResult.errorsCorrected()};
+		auto position = Rectangle<PointI>(bits.width(), bits.height());
+		res[i] = Barcode(std::move(decoderResult), DetectorResult(std::move(bits), std::move(position)), symbolFormat);
+		res[i].setReaderOptions(opts);
+	};
+
+	// every symbol is decoded on its own, so the threads simply take turns (an exception is rethrown on this thread)
+	int maxThreads = std::min(MaxThreads(opts), Size(symbols));
+	RunOnThreads(maxThreads, [&](int t) {
+		for (int i = t; i < Size(symbols); i += maxThreads)
+			decode(i);
+	});
+
+	return res;
+}
+
+#else
+
+Barcodes DecodeSymbols(const std::vector<ImageView>&, BarcodeFormat, const ReaderOptions&, std::vector<ErrorCorrectionStats>*)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
+}
+
+#endif // ZXING_READERS
+
+#endif // ZXING_EXPERIMENTAL_API
+
 } // ZXing
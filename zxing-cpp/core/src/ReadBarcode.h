@@ -9,6 +9,9 @@
 #include "ImageView.h"
 #include "Barcode.h"
 
+#include <memory>
+#include <vector>
+
 namespace ZXing {
 
 /**
@@ -29,5 +32,65 @@ Barcode ReadBarcode(const ImageView& image, const ReaderOptions& options = {});
  */
 Barcodes ReadBarcodes(const ImageView& image, const ReaderOptions& options = {});
 
+#ifdef ZXING_EXPERIMENTAL_API
+
+/**
+ * Reads linear barcodes from a stream of image rows, e.g. delivered one at a time by a line-scan camera, without
+ * assembling full frames. Every row is decoded as it arrives and a barcode is returned as soon as it has been seen on
+ * ReaderOptions::minLineCount() rows. Only the last maxHistory rows are remembered, so the stream can be endless.
+ * Matrix formats in ReaderOptions::formats() are ignored.
+ */
+// WARNING: this API is experimental and may change/disappear
+class LineScanReader
+{
+	struct Data;
+	std::unique_ptr<Data> d;
+
+public:
+	explicit LineScanReader(const ReaderOptions& options = {}, int maxHistory = 1024);
+	~LineScanReader();
+	LineScanReader(LineScanReader&&);
+	LineScanReader& operator=(LineScanReader&&);
+
+	/**
+	 * Decode the rows of image as the next rows of the stream
+	 *
+	 * @param rows  view of one or more rows of image data, all of the same width
+	 * @return #Barcodes  list of barcodes that were completed by these rows, their position is in stream coordinates
+	 */
+	Barcodes addRows(const ImageView& rows);
+
+	/// the number of rows added so far, i.e. the y coordinate of the next row in the stream
+	int rowCount() const;
+
+	/// start a new stream, forgetting all rows seen so far
+	void reset();
+};
+
+/// Error correction statistics of a symbol decoded with DecodeSymbols()
+// WARNING: this API is experimental and may change/disappear
+struct ErrorCorrectionStats
+{
+	int ecCodewords = 0;     ///< number of error correction codewords, up to half of them can be fixed
+	int errorsCorrected = 0; ///< number of codewords fixed by the error correction (meaningless with a ChecksumError)
+};
+
+/**
+ * Decode symbols that are already sampled into module grids, skipping the detection. This is meant for applications that
+ * know where the symbols are, e.g. to verify printed output, and decodes many of them at once on up to
+ * ReaderOptions::maxThreads() threads.
+ *
+ * @param symbols  one view per symbol with one pixel per module and no quiet zone, dark modules <= 127 (see Barcode::symbol())
+ * @param format  BarcodeFormat::QRCode, MicroQRCode, RMQRCode (the exact one is derived from the size) or DataMatrix
+ * @param options  optional ReaderOptions, only maxThreads, textMode and characterSet are used
+ * @param stats  optional, filled with the error correction statistics of every symbol
+ * @return #Barcodes  one barcode per symbol in the same order, check isValid() and error() for the ones that failed
+ */
+// WARNING: this API is experimental and may change/disappear
+Barcodes DecodeSymbols(const std::vector<ImageView>& symbols, BarcodeFormat format, const ReaderOptions& options = {},
+					   std::vector<ErrorCorrectionStats>* stats = nullptr);
+
+#endif // ZXING_EXPERIMENTAL_API
+
 } // ZXing
 
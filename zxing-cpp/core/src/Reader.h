@@ -28,6 +28,10 @@ public:
 
 	virtual Barcode decode(const BinaryBitmap& image) const = 0;
 
+	// true if decode(image, maxSymbols) also finds the inverted symbols in a non-inverted image, so there is no need to
+	// call it again with the inverted one (see ReaderOptions::tryInvert)
+	virtual bool findsInverted() const { return false; }
+
 	// WARNING: this API is experimental and may change/disappear
 	virtual Barcodes decode(const BinaryBitmap& image, [[maybe_unused]] int maxSymbols) const {
 		auto res = decode(image);
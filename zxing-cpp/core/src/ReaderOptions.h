@@ -65,10 +65,16 @@ class ReaderOptions
 	CharacterSet _characterSet     : 6;
 #ifdef ZXING_EXPERIMENTAL_API
 	bool _tryDenoise               : 1;
+	bool _adaptiveRowScan          : 1;
+	bool _subPixelRows             : 1;
 #endif
 
 	uint8_t _minLineCount        = 2;
 	uint8_t _maxNumberOfSymbols  = 0xff;
+#ifdef ZXING_EXPERIMENTAL_API
+	uint8_t _maxThreads          = 1;
+	uint8_t _scanLineDirections  = 0;
+#endif
 	uint16_t _downscaleThreshold = 500;
 	BarcodeFormats _formats      = BarcodeFormat::None;
 
@@ -92,7 +98,9 @@ public:
 		  _characterSet(CharacterSet::Unknown)
 #ifdef ZXING_EXPERIMENTAL_API
 		  ,
-		  _tryDenoise(0)
+		  _tryDenoise(0),
+		  _adaptiveRowScan(0),
+		  _subPixelRows(0)
 #endif
 	{}
 
@@ -121,6 +129,29 @@ public:
 	ZX_PROPERTY(bool, tryDenoise, setTryDenoise)
 #endif
 
+#ifdef ZXING_EXPERIMENTAL_API
+	/// Maximum number of threads used to scan the rows of linear symbols with tryHarder and to search the finder patterns
+	/// of QR codes, 0 means hardware concurrency. The result does not depend on the number of threads. Default is 1.
+	// WARNING: this API is experimental and may change/disappear
+	ZX_PROPERTY(uint8_t, maxThreads, setMaxThreads)
+
+	/// Scan linear symbols on a sparse grid of rows first and only add rows around the ones that show a hint of a symbol.
+	/// This finds small symbols anywhere in the image without scanning all rows like tryHarder. Default is false.
+	// WARNING: this API is experimental and may change/disappear
+	ZX_PROPERTY(bool, adaptiveRowScan, setAdaptiveRowScan)
+
+	/// Locate the edges between the bars and spaces of linear symbols in the rows and columns of the image with sub-pixel
+	/// precision in the luminance data instead of at pixel boundaries (see BinaryBitmap::getSubPixelPatternRow()). This
+	/// helps reading small symbols with modules of 1 to 2 pixels. Default is false.
+	// WARNING: this API is experimental and may change/disappear
+	ZX_PROPERTY(bool, subPixelRows, setSubPixelRows)
+
+	/// Number of scan line directions evenly spread over 180 degrees used to find linear symbols, e.g. 8 means every 22.5
+	/// degrees. The rows are always scanned, the columns only with tryRotate. Default is 0 (only rows and columns).
+	// WARNING: this API is experimental and may change/disappear
+	ZX_PROPERTY(uint8_t, scanLineDirections, setScanLineDirections)
+#endif
+
 	/// Binarizer to use internally when using the ReadBarcode function
 	ZX_PROPERTY(Binarizer, binarizer, setBinarizer)
 
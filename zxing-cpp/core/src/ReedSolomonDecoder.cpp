@@ -16,14 +16,15 @@
 
 namespace ZXing {
 
+// all polynomials are thread local (like sigma and omega of the caller), so their memory is reused from block to block
 static bool
-RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, GenericGFPoly& sigma, GenericGFPoly& omega)
+RunEuclideanAlgorithm(const GenericGF& field, const std::vector<int>& rCoefs, GenericGFPoly& sigma, GenericGFPoly& omega)
 {
 	int R = Size(rCoefs); // == numECCodeWords
-	GenericGFPoly r(field, std::move(rCoefs));
+	ZX_THREAD_LOCAL GenericGFPoly q, r, rLast;
+	r.setField(field).setCoefficients(rCoefs);
 	GenericGFPoly& tLast = omega.setField(field);
 	GenericGFPoly& t = sigma.setField(field);
-	ZX_THREAD_LOCAL GenericGFPoly q, rLast;
 
 	rLast.setField(field);
 	q.setField(field);
@@ -64,34 +65,32 @@ RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, Generic
 	r.multiplyByMonomial(inverse);
 
 	// sigma is t
-	omega = std::move(r);
+	swap(omega, r);
 	return true;
 }
 
-static std::vector<int>
-FindErrorLocations(const GenericGF& field, const GenericGFPoly& errorLocator)
+static bool
+FindErrorLocations(const GenericGF& field, const GenericGFPoly& errorLocator, std::vector<int>& res)
 {
 	// This is a direct application of Chien's search
 	int numErrors = errorLocator.degree();
-	std::vector<int> res;
-	res.reserve(numErrors);
+	res.clear();
 
 	for (int i = 1; i < field.size() && Size(res) < numErrors; i++)
 		if (errorLocator.evaluateAt(i) == 0)
 			res.push_back(field.inverse(i));
 
-	if (Size(res) != numErrors)
-		return {}; // Error locator degree does not match number of roots
-
-	return res;
+	// Error locator degree does not match number of roots?
+	return numErrors > 0 && Size(res) == numErrors;
 }
 
-static std::vector<int>
-FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator, const std::vector<int>& errorLocations)
+static void
+FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator, const std::vector<int>& errorLocations,
+					std::vector<int>& res)
 {
 	// This is directly applying Forney's Formula
 	int s = Size(errorLocations);
-	std::vector<int> res(s);
+	res.resize(s);
 	for (int i = 0; i < s; ++i) {
 		int xiInverse = field.inverse(errorLocations[i]);
 		int denom = 1;
@@ -102,41 +101,51 @@ FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator,
 		if (field.generatorBase() != 0)
 			res[i] = field.multiply(res[i], xiInverse);
 	}
-	return res;
 }
 
 bool
-ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+ReedSolomonDecode(const GenericGF& field, int* message, int messageLength, int numECCodeWords, int* numErrors)
 {
-	GenericGFPoly poly(field, message);
-
-	std::vector<int> syndromes(numECCodeWords);
+	if (numErrors)
+		*numErrors = 0;
+
+	// evaluate the message polynomial directly instead of copying it into a GenericGFPoly first
+	auto evaluateAt = [&](int a) {
+		int res = 0;
+		for (int i = 0; i < messageLength; ++i)
+			res = field.multiply(a, res) ^ message[i];
+		return res;
+	};
+
+	ZX_THREAD_LOCAL std::vector<int> syndromes;
+	syndromes.resize(numECCodeWords);
 	for (int i = 0; i < numECCodeWords; i++)
-		syndromes[numECCodeWords - 1 - i] = poly.evaluateAt(field.exp(i + field.generatorBase()));
+		syndromes[numECCodeWords - 1 - i] = evaluateAt(field.exp(i + field.generatorBase()));
 
 	// if all syndromes are 0 there is no error to correct
 	if (std::all_of(syndromes.begin(), syndromes.end(), [](int c) { return c == 0; }))
 		return true;
 
 	ZX_THREAD_LOCAL GenericGFPoly sigma, omega;
+	ZX_THREAD_LOCAL std::vector<int> errorLocations, errorMagnitudes;
 
-	if (!RunEuclideanAlgorithm(field, std::move(syndromes), sigma, omega))
+	if (!RunEuclideanAlgorithm(field, syndromes, sigma, omega))
 		return false;
 
-	auto errorLocations = FindErrorLocations(field, sigma);
-	if (errorLocations.empty())
+	if (!FindErrorLocations(field, sigma, errorLocations))
 		return false;
 
-	auto errorMagnitudes = FindErrorMagnitudes(field, omega, errorLocations);
+	FindErrorMagnitudes(field, omega, errorLocations, errorMagnitudes);
 
-	int msgLen = Size(message);
 	for (int i = 0; i < Size(errorLocations); ++i) {
-		int position = msgLen - 1 - field.log(errorLocations[i]);
+		int position = messageLength - 1 - field.log(errorLocations[i]);
 		if (position < 0)
 			return false;
 
 		message[position] ^= errorMagnitudes[i];
 	}
+	if (numErrors)
+		*numErrors = Size(errorLocations);
 	return true;
 }
 
@@ -39,9 +39,16 @@ class GenericGF;
  * @brief ReedSolomonDecode fixes errors in a message containing both data and parity codewords.
  *
  * @param message data and error-correction/parity codewords
+ * @param messageLength number of codewords in message
  * @param numECCodeWords number of error-correction code words
+ * @param numErrors optional, set to the number of codewords that were fixed
  * @return true iff message errors could successfully be fixed (or there have not been any)
  */
-bool ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords);
+bool ReedSolomonDecode(const GenericGF& field, int* message, int messageLength, int numECCodeWords, int* numErrors = nullptr);
+
+inline bool ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords, int* numErrors = nullptr)
+{
+	return ReedSolomonDecode(field, message.data(), static_cast<int>(message.size()), numECCodeWords, numErrors);
+}
 
 } // ZXing
@@ -21,22 +21,47 @@ namespace ZXing {
 class RegressionLine
 {
 protected:
+	using value_t = PointF::value_t;
+
+	// The running sums (moments) of a set of points required for the least squares fit. They are taken relative to
+	// the first point to keep them numerically well-behaved. Adding or removing a point and evaluating the fit is O(1).
+	struct Moments
+	{
+		PointF origin;
+		value_t n = 0, sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+
+		void add(PointF p, value_t w = 1)
+		{
+			if (n == 0)
+				origin = p;
+			auto d = p - origin;
+			n += w;
+			sx += w * d.x;
+			sy += w * d.y;
+			sxx += w * d.x * d.x;
+			syy += w * d.y * d.y;
+			sxy += w * d.x * d.y;
+			if (n == 0)
+				*this = {};
+		}
+		void remove(PointF p) { add(p, -1); }
+		PointF mean() const { return origin + PointF(sx, sy) / n; }
+	};
+
 	std::vector<PointF> _points;
+	std::vector<PointF> _filtered; // scratch buffer of evaluate(maxSignedDist), kept to reuse its capacity
+	Moments _moments;
 	PointF _directionInward;
-	PointF::value_t a = NAN, b = NAN, c = NAN;
+	value_t a = NAN, b = NAN, c = NAN;
 
 	friend PointF intersect(const RegressionLine& l1, const RegressionLine& l2);
 
-	template<typename T> bool evaluate(const PointT<T>* begin, const PointT<T>* end)
+	bool evaluate(const Moments& m)
 	{
-		auto mean = Reduce(begin, end, PointF()) / std::distance(begin, end);
-		PointF::value_t sumXX = 0, sumYY = 0, sumXY = 0;
-		for (auto p = begin; p != end; ++p) {
-			auto d = *p - mean;
-			sumXX += d.x * d.x;
-			sumYY += d.y * d.y;
-			sumXY += d.x * d.y;
-		}
+		// the centered sums of squares, computed from the moments relative to m.origin
+		auto sumXX = m.sxx - m.sx * m.sx / m.n;
+		auto sumYY = m.syy - m.sy * m.sy / m.n;
+		auto sumXY = m.sxy - m.sx * m.sy / m.n;
 		if (sumYY >= sumXX) {
 			auto l = std::sqrt(sumYY * sumYY + sumXY * sumXY);
 			a = +sumYY / l;
@@ -50,10 +75,18 @@ protected:
 			a = -a;
 			b = -b;
 		}
-		c = dot(normal(), mean); // (a*mean.x + b*mean.y);
+		c = dot(normal(), m.mean()); // (a*mean.x + b*mean.y);
 		return dot(_directionInward, normal()) > 0.5f; // angle between original and new direction is at most 60 degree
 	}
 
+	template<typename T> bool evaluate(const PointT<T>* begin, const PointT<T>* end)
+	{
+		Moments m;
+		for (auto p = begin; p != end; ++p)
+			m.add(PointF(*p));
+		return evaluate(m);
+	}
+
 	template <typename T> bool evaluate(const std::vector<PointT<T>>& points) { return evaluate(&points.front(), &points.back() + 1); }
 
 	template <typename T> static auto distance(PointT<T> a, PointT<T> b) { return ZXing::distance(a, b); }
@@ -78,11 +111,12 @@ public:
 	auto signedDistance(PointF p) const { return dot(normal(), p) - c; }
 	template <typename T> auto distance(PointT<T> p) const { return std::abs(signedDistance(PointF(p))); }
 	PointF project(PointF p) const { return p - signedDistance(p) * normal(); }
-	PointF centroid() const { return Reduce(_points) / _points.size(); }
+	PointF centroid() const { return _moments.mean(); }
 
 	void reset()
 	{
 		_points.clear();
+		_moments = {};
 		_directionInward = {};
 		a = b = c = NAN;
 	}
@@ -90,39 +124,50 @@ public:
 	void add(PointF p) {
 		assert(_directionInward != PointF());
 		_points.push_back(p);
+		_moments.add(p);
 		if (_points.size() == 1)
 			c = dot(normal(), p);
 	}
 
-	void pop_back() { _points.pop_back(); }
+	void pop_back()
+	{
+		_moments.remove(_points.back());
+		_points.pop_back();
+	}
 	void pop_front()
 	{
+		_moments.remove(_points.front());
 		std::rotate(_points.begin(), _points.begin() + 1, _points.end());
 		_points.pop_back();
 	}
+	void resize(size_t n)
+	{
+		for (size_t i = n; i < _points.size(); ++i)
+			_moments.remove(_points[i]);
+		_points.resize(n);
+	}
 
 	void setDirectionInward(PointF d) { _directionInward = normalized(d); }
 
 	bool evaluate(double maxSignedDist = -1, bool updatePoints = false)
 	{
-		bool ret = evaluate(_points);
+		bool ret = evaluate(_moments);
 		if (maxSignedDist > 0) {
-			auto points = _points;
+			auto& points = _filtered;
+			auto moments = _moments;
+			points.assign(_points.begin(), _points.end());
 			while (true) {
 				auto old_points_size = points.size();
 				// remove points that are further 'inside' than maxSignedDist or further 'outside' than 2 x maxSignedDist
-#ifdef __cpp_lib_erase_if
-				std::erase_if(points, [this, maxSignedDist](auto p) {
-					auto sd = this->signedDistance(p);
-					return sd > maxSignedDist || sd < -2 * maxSignedDist;
-				});
-#else
-				auto end = std::remove_if(points.begin(), points.end(), [this, maxSignedDist](auto p) {
-					auto sd = this->signedDistance(p);
-					return sd > maxSignedDist || sd < -2 * maxSignedDist;
-				});
-				points.erase(end, points.end());
-#endif
+				size_t n = 0;
+				for (auto p : points) {
+					auto sd = signedDistance(p);
+					if (sd > maxSignedDist || sd < -2 * maxSignedDist)
+						moments.remove(p);
+					else
+						points[n++] = p;
+				}
+				points.resize(n);
 				// if we threw away too many points, something is off with the line to begin with
 				if (points.size() < old_points_size / 2 || points.size() < 2)
 					return false;
@@ -132,11 +177,13 @@ public:
 				printf("removed %zu points -> %zu remaining\n", old_points_size - points.size(), points.size());
 				fflush(stdout);
 #endif
-				ret = evaluate(points);
+				ret = evaluate(moments);
 			}
 
-			if (updatePoints)
-				_points = std::move(points);
+			if (updatePoints) {
+				std::swap(_points, points);
+				_moments = moments;
+			}
 		}
 		return ret;
 	}
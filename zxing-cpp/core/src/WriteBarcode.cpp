@@ -32,6 +32,7 @@ struct CreatorOptions::Data
 	bool readerInit = false;
 	bool forceSquareDataMatrix = false;
 	std::string ecLevel;
+	bool compact = false;
 
 	// symbol size (qrcode, datamatrix, etc), map from I, 'WxH'
 	// structured_append (idx, cnt, ID)
@@ -52,6 +53,7 @@ struct CreatorOptions::Data
 	ZX_PROPERTY(bool, readerInit)
 	ZX_PROPERTY(bool, forceSquareDataMatrix)
 	ZX_PROPERTY(std::string, ecLevel)
+	ZX_PROPERTY(bool, compact)
 
 #undef ZX_PROPERTY
 
@@ -149,27 +151,54 @@ struct BarcodeFormatZXing2Zint
 	int zint;
 };
 
+// only the symbologies included in this build, see the ZXING_FORMATS cmake option
 static constexpr BarcodeFormatZXing2Zint barcodeFormatZXing2Zint[] = {
+#ifndef ZXING_DISABLE_AZTEC
 	{BarcodeFormat::Aztec, BARCODE_AZTEC},
+#endif
+#ifndef ZXING_DISABLE_CODABAR
 	{BarcodeFormat::Codabar, BARCODE_CODABAR},
+#endif
+#ifndef ZXING_DISABLE_CODE39
 	{BarcodeFormat::Code39, BARCODE_CODE39},
+#endif
+#ifndef ZXING_DISABLE_CODE93
 	{BarcodeFormat::Code93, BARCODE_CODE93},
+#endif
+#ifndef ZXING_DISABLE_CODE128
 	{BarcodeFormat::Code128, BARCODE_CODE128},
+#endif
+#ifndef ZXING_DISABLE_DATABAR
 	{BarcodeFormat::DataBar, BARCODE_DBAR_OMN},
 	{BarcodeFormat::DataBarExpanded, BARCODE_DBAR_EXP},
 	{BarcodeFormat::DataBarLimited, BARCODE_DBAR_LTD},
+#endif
+#ifndef ZXING_DISABLE_DATAMATRIX
 	{BarcodeFormat::DataMatrix, BARCODE_DATAMATRIX},
+#endif
+#ifndef ZXING_DISABLE_DXFILMEDGE
 	{BarcodeFormat::DXFilmEdge, BARCODE_DXFILMEDGE},
+#endif
+#ifndef ZXING_DISABLE_EANUPC
 	{BarcodeFormat::EAN8, BARCODE_EANX},
 	{BarcodeFormat::EAN13, BARCODE_EANX},
+	{BarcodeFormat::UPCA, BARCODE_UPCA},
+	{BarcodeFormat::UPCE, BARCODE_UPCE},
+#endif
+#ifndef ZXING_DISABLE_ITF
 	{BarcodeFormat::ITF, BARCODE_C25INTER},
+#endif
+#ifndef ZXING_DISABLE_MAXICODE
 	{BarcodeFormat::MaxiCode, BARCODE_MAXICODE},
-	{BarcodeFormat::MicroQRCode, BARCODE_MICROQR},
+#endif
+#ifndef ZXING_DISABLE_PDF417
 	{BarcodeFormat::PDF417, BARCODE_PDF417},
+#endif
+#ifndef ZXING_DISABLE_QRCODE
+	{BarcodeFormat::MicroQRCode, BARCODE_MICROQR},
 	{BarcodeFormat::QRCode, BARCODE_QRCODE},
 	{BarcodeFormat::RMQRCode, BARCODE_RMQR},
-	{BarcodeFormat::UPCA, BARCODE_UPCA},
-	{BarcodeFormat::UPCE, BARCODE_UPCE},
+#endif
 };
 
 struct String2Int
@@ -352,6 +381,7 @@ Barcode CreateBarcodeFromText(std::string_view contents, const CreatorOptions& o
 	if (!opts.ecLevel().empty())
 		writer.setEccLevel(std::stoi(opts.ecLevel()));
 	writer.setEncoding(CharacterSet::UTF8); // write UTF8 (ECI value 26) for maximum compatibility
+	writer.setCompact(opts.compact());
 
 	return CreateBarcode(writer.encode(std::string(contents), 0, IsLinearCode(opts.format()) ? 50 : 0), opts);
 }
@@ -43,6 +43,7 @@ public:
 	ZX_PROPERTY(bool, readerInit)
 	ZX_PROPERTY(bool, forceSquareDataMatrix)
 	ZX_PROPERTY(std::string, ecLevel)
+	ZX_PROPERTY(bool, compact) // QR Code: use the mixed mode segments needing the fewest bits (always done by libzint)
 
 #undef ZX_PROPERTY
 };
@@ -0,0 +1,65 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "ReaderOptions.h"
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace ZXing {
+
+// The number of threads to use with opts, at least 1 (see ReaderOptions::maxThreads()).
+inline int MaxThreads([[maybe_unused]] const ReaderOptions& opts)
+{
+#if defined(PRINT_DEBUG)
+	return 1; // the debug logs are not thread safe
+#elif defined(ZXING_EXPERIMENTAL_API)
+	return opts.maxThreads() ? opts.maxThreads() : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+#else
+	return 1;
+#endif
+}
+
+// Runs func(t) for t = 0..n-1 and waits for all of them to finish. t = 0 runs on the calling thread, each of the others
+// on a std::thread started for this call only. If a thread can not be started, its t and all following ones run on the
+// calling thread as well. If any func(t) throws, the exception of the lowest t is rethrown on the calling thread.
+template <typename Func>
+void RunOnThreads(int n, Func func)
+{
+	std::vector<std::exception_ptr> errors(std::max(n, 1));
+	auto run = [&](int t) {
+		try {
+			func(t);
+		} catch (...) {
+			errors[t] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(std::max(n - 1, 0));
+	int started = 1;
+	try {
+		for (; started < n; ++started)
+			threads.emplace_back(run, started);
+	} catch (const std::system_error&) {
+		// out of threads (or resources): letting the already running ones be destroyed would call std::terminate
+	}
+	run(0);
+	for (int t = started; t < n; ++t)
+		run(t);
+	for (auto& thread : threads)
+		thread.join();
+
+	for (auto& error : errors)
+		if (error)
+			std::rethrow_exception(error);
+}
+
+} // ZXing
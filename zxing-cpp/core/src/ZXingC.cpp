@@ -341,6 +341,7 @@ void ZXing_CreatorOptions_delete(ZXing_CreatorOptions* opts)
 
 ZX_PROPERTY(bool, readerInit, ReaderInit)
 ZX_PROPERTY(bool, forceSquareDataMatrix, ForceSquareDataMatrix)
+ZX_PROPERTY(bool, compact, Compact)
 
 #undef ZX_PROPERTY
 
@@ -277,6 +277,9 @@ bool ZXing_CreatorOptions_getReaderInit(const ZXing_CreatorOptions* opts);
 void ZXing_CreatorOptions_setForceSquareDataMatrix(ZXing_CreatorOptions* opts, bool forceSquareDataMatrix);
 bool ZXing_CreatorOptions_getForceSquareDataMatrix(const ZXing_CreatorOptions* opts);
 
+void ZXing_CreatorOptions_setCompact(ZXing_CreatorOptions* opts, bool compact);
+bool ZXing_CreatorOptions_getCompact(const ZXing_CreatorOptions* opts);
+
 void ZXing_CreatorOptions_setEcLevel(ZXing_CreatorOptions* opts, const char* ecLevel);
 char* ZXing_CreatorOptions_getEcLevel(const ZXing_CreatorOptions* opts);
 
@@ -21,18 +21,71 @@ const std::string& Version()
 
 #ifdef ZXING_EXPERIMENTAL_API
 
+// The symbologies included in this build, see the ZXING_FORMATS cmake option
+static BarcodeFormats BuiltBarcodeFormats()
+{
+	auto res = BarcodeFormats(BarcodeFormat::Any);
+#ifdef ZXING_DISABLE_AZTEC
+	res.setFlag(BarcodeFormat::Aztec, false);
+#endif
+#ifdef ZXING_DISABLE_CODABAR
+	res.setFlag(BarcodeFormat::Codabar, false);
+#endif
+#ifdef ZXING_DISABLE_CODE39
+	res.setFlag(BarcodeFormat::Code39, false);
+#endif
+#ifdef ZXING_DISABLE_CODE93
+	res.setFlag(BarcodeFormat::Code93, false);
+#endif
+#ifdef ZXING_DISABLE_CODE128
+	res.setFlag(BarcodeFormat::Code128, false);
+#endif
+#ifdef ZXING_DISABLE_DATABAR
+	res.setFlag(BarcodeFormat::DataBar, false);
+	res.setFlag(BarcodeFormat::DataBarExpanded, false);
+	res.setFlag(BarcodeFormat::DataBarLimited, false);
+#endif
+#ifdef ZXING_DISABLE_DATAMATRIX
+	res.setFlag(BarcodeFormat::DataMatrix, false);
+#endif
+#ifdef ZXING_DISABLE_DXFILMEDGE
+	res.setFlag(BarcodeFormat::DXFilmEdge, false);
+#endif
+#ifdef ZXING_DISABLE_EANUPC
+	res.setFlag(BarcodeFormat::EAN8, false);
+	res.setFlag(BarcodeFormat::EAN13, false);
+	res.setFlag(BarcodeFormat::UPCA, false);
+	res.setFlag(BarcodeFormat::UPCE, false);
+#endif
+#ifdef ZXING_DISABLE_ITF
+	res.setFlag(BarcodeFormat::ITF, false);
+#endif
+#ifdef ZXING_DISABLE_MAXICODE
+	res.setFlag(BarcodeFormat::MaxiCode, false);
+#endif
+#ifdef ZXING_DISABLE_PDF417
+	res.setFlag(BarcodeFormat::PDF417, false);
+#endif
+#ifdef ZXING_DISABLE_QRCODE
+	res.setFlag(BarcodeFormat::QRCode, false);
+	res.setFlag(BarcodeFormat::MicroQRCode, false);
+	res.setFlag(BarcodeFormat::RMQRCode, false);
+#endif
+	return res;
+}
+
 BarcodeFormats SupportedBarcodeFormats(Operation op)
 {
 	switch (op) {
 	case Operation::Read:
 #ifdef ZXING_READERS
-		return BarcodeFormat::Any;
+		return BuiltBarcodeFormats();
 #else
 		return BarcodeFormat::None;
 #endif
 	case Operation::Create:
 #if defined(ZXING_WRITERS) && defined(ZXING_EXPERIMENTAL_API)
-		return BarcodeFormats(BarcodeFormat::Any).setFlag(BarcodeFormat::DXFilmEdge, false);
+		return BuiltBarcodeFormats().setFlag(BarcodeFormat::DXFilmEdge, false);
 #else
 		return BarcodeFormat::None;
 #endif
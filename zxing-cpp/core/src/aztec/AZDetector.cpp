@@ -125,8 +125,10 @@ static std::vector<ConcentricPattern> FindPureFinderPattern(const BitMatrix& ima
 		return {};
 }
 
-static std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+static std::vector<ConcentricPattern> FindFinderPatterns(const DualPolarityBitMatrix& images, bool tryHarder)
 {
+	const BitMatrix& image = images(false);
+
 	std::vector<ConcentricPattern> res;
 
 	[[maybe_unused]] int N = 0;
@@ -187,43 +189,52 @@ static std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image,
 	for (int y = margin; y < image.height() - margin; y += skip)
 	{
 		GetPatternRow(image, y, row, false);
-		PatternView next = row;
-		next.shift(1); // the center pattern we are looking for starts with white and is 7 wide (compact code)
+
+		// the center pattern of an inverted symbol is found in the same row, starting with black instead of white
+		for (bool inverted : {false, true}) {
+			if (inverted && !images.tryInverted())
+				break;
+
+			PatternView next = row;
+			if (!inverted)
+				next.shift(1); // the center pattern we are looking for starts with white and is 7 wide (compact code)
 
 #if 1
-		while (next = FindAztecCenterPattern(next), next.isValid()) {
+			while (next = FindAztecCenterPattern(next), next.isValid()) {
 #else
-		constexpr auto PATTERN = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
-		while (next = FindLeftGuard(next, 0, PATTERN, 0.5), next.isValid()) {
+			constexpr auto PATTERN = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
+			while (next = FindLeftGuard(next, 0, PATTERN, 0.5), next.isValid()) {
 #endif
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] + next[3] / 2.0, y + 0.5);
-
-			// make sure p is not 'inside' an already found pattern area
-			bool found = false;
-			for (auto old = res.rbegin(); old != res.rend(); ++old) {
-				// search from back to front, stop once we are out of range due to the y-coordinate
-				if (p.y - old->y > old->size / 2)
-					break;
-				if (distance(p, *old) < old->size / 2) {
-					found = true;
-					break;
+				PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] + next[3] / 2.0, y + 0.5);
+
+				// make sure p is not 'inside' an already found pattern area
+				bool found = false;
+				for (auto old = res.rbegin(); old != res.rend(); ++old) {
+					// search from back to front, stop once we are out of range due to the y-coordinate
+					if (p.y - old->y > old->size / 2)
+						break;
+					if (distance(p, *old) < old->size / 2) {
+						found = true;
+						break;
+					}
 				}
-			}
 
-			if (!found) {
-				++N;
-				log(p, 1);
+				if (!found) {
+					++N;
+					log(p, 1);
 
-				auto pattern = LocateAztecCenter(image, p, next.sum());
-				if (pattern) {
-					log(*pattern, 3);
-					assert(image.get(*pattern));
-					res.push_back(*pattern);
+					auto pattern = LocateAztecCenter(images(inverted), p, next.sum());
+					if (pattern) {
+						log(*pattern, 3);
+						assert(images(inverted).get(*pattern));
+						pattern->isInverted = inverted;
+						res.push_back(*pattern);
+					}
 				}
-			}
 
-			next.skipPair();
-			next.extend();
+				next.skipPair();
+				next.extend();
+			}
 		}
 	}
 #endif
@@ -348,15 +359,17 @@ DetectorResult Detect(const BitMatrix& image, bool isPure, bool tryHarder)
 	return FirstOrDefault(Detect(image, isPure, tryHarder, 1));
 }
 
-DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int maxSymbols)
+DetectorResults Detect(const BitMatrix& origImage, bool isPure, bool tryHarder, int maxSymbols, bool tryInverted)
 {
 #ifdef PRINT_DEBUG
-	LogMatrixWriter lmw(log, image, 5, "az-log.pnm");
+	LogMatrixWriter lmw(log, origImage, 5, "az-log.pnm");
 #endif
 
 	DetectorResults res;
-	auto fps = isPure ? FindPureFinderPattern(image) : FindFinderPatterns(image, tryHarder);
+	DualPolarityBitMatrix images(origImage, tryInverted && !isPure);
+	auto fps = isPure ? FindPureFinderPattern(origImage) : FindFinderPatterns(images, tryHarder);
 	for (const auto& fp : fps) {
+		const BitMatrix& image = images(fp.isInverted);
 		auto fpQuad = FindConcentricPatternCorners(image, fp, fp.size, 3);
 		if (!fpQuad)
 			continue;
@@ -432,7 +445,8 @@ DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int
 		if (!bits.isValid())
 			continue;
 
-		res.emplace_back(std::move(bits), radius == 5, nbDataBlocks, nbLayers, readerInit, mirror != 0, isRune ? modeMessage : -1);
+		res.emplace_back(std::move(bits), radius == 5, nbDataBlocks, nbLayers, readerInit, mirror != 0, isRune ? modeMessage : -1,
+						 fp.isInverted);
 
 		if (Size(res) == maxSymbols)
 			break;
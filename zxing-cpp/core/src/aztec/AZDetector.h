@@ -19,7 +19,8 @@ class DetectorResult;
 DetectorResult Detect(const BitMatrix& image, bool isPure, bool tryHarder = true);
 
 using DetectorResults = std::vector<DetectorResult>;
-DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int maxSymbols);
+// if tryInverted is set, inverted symbols are looked for in the same pass, see DualPolarityBitMatrix
+DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int maxSymbols, bool tryInverted = false);
 
 } // Aztec
 } // ZXing
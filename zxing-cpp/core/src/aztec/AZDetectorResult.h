@@ -20,6 +20,7 @@ class DetectorResult : public ZXing::DetectorResult
 	bool _readerInit = false;
 	bool _isMirrored = false;
 	int _runeValue = -1;
+	bool _isInverted = false;
 
 	DetectorResult(const DetectorResult&) = delete;
 	DetectorResult& operator=(const DetectorResult&) = delete;
@@ -29,14 +30,16 @@ public:
 	DetectorResult(DetectorResult&&) noexcept = default;
 	DetectorResult& operator=(DetectorResult&&) noexcept = default;
 
-	DetectorResult(ZXing::DetectorResult&& result, bool isCompact, int nbDatablocks, int nbLayers, bool readerInit, bool isMirrored, int runeValue)
+	DetectorResult(ZXing::DetectorResult&& result, bool isCompact, int nbDatablocks, int nbLayers, bool readerInit, bool isMirrored,
+				   int runeValue, bool isInverted = false)
 		: ZXing::DetectorResult{std::move(result)},
 		  _compact(isCompact),
 		  _nbDatablocks(nbDatablocks),
 		  _nbLayers(nbLayers),
 		  _readerInit(readerInit),
 		  _isMirrored(isMirrored),
-		  _runeValue(runeValue)
+		  _runeValue(runeValue),
+		  _isInverted(isInverted)
 	{}
 
 	bool isCompact() const { return _compact; }
@@ -44,6 +47,7 @@ public:
 	int nbLayers() const { return _nbLayers; }
 	bool readerInit() const { return _readerInit; }
 	bool isMirrored() const { return _isMirrored; }
+	bool isInverted() const { return _isInverted; }
 
 	// Only meaningful is nbDatablocks == 0
 	int runeValue() const { return _runeValue; }
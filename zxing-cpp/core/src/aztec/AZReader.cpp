@@ -43,14 +43,17 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	if (binImg == nullptr)
 		return {};
 	
-	auto detRess = Detect(*binImg, _opts.isPure(), _opts.tryHarder(), maxSymbols);
+	// inverted symbols are looked for in the same pass, instead of a second one over the inverted image (see findsInverted)
+	auto detRess = Detect(*binImg, _opts.isPure(), _opts.tryHarder(), maxSymbols, findsInverted() && !image.inverted());
 
 	Barcodes baracodes;
 	for (auto&& detRes : detRess) {
 		auto decRes =
 			Decode(detRes).setReaderInit(detRes.readerInit()).setIsMirrored(detRes.isMirrored()).setVersionNumber(detRes.nbLayers());
 		if (decRes.isValid(_opts.returnErrors())) {
+			bool isInverted = detRes.isInverted();
 			baracodes.emplace_back(std::move(decRes), std::move(detRes), BarcodeFormat::Aztec);
+			SetIsInverted(baracodes.back(), isInverted);
 			if (maxSymbols > 0 && Size(baracodes) >= maxSymbols)
 				break;
 		}
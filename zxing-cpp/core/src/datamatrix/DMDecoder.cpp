@@ -372,16 +372,17 @@ DecoderResult Decode(ByteArray&& bytes, const bool isDMRE)
 *
 * @param codewordBytes data and error correction codewords
 * @param numDataCodewords number of codewords that are data bytes
+* @param numErrors set to the number of codewords that were fixed
 * @return false if error correction fails
 */
 static bool
-CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
+CorrectErrors(ByteArray& codewordBytes, int numDataCodewords, int& numErrors)
 {
 	// First read into an array of ints
 	std::vector<int> codewordsInts(codewordBytes.begin(), codewordBytes.end());
 	int numECCodewords = Size(codewordBytes) - numDataCodewords;
 
-	if (!ReedSolomonDecode(GenericGF::DataMatrixField256(), codewordsInts, numECCodewords))
+	if (!ReedSolomonDecode(GenericGF::DataMatrixField256(), codewordsInts, numECCodewords, &numErrors))
 		return false;
 
 	// Copy back into array of bytes -- only need to worry about the bytes that were data
@@ -415,15 +416,18 @@ retry:
 
 	// Error-correct and copy data blocks together into a stream of bytes
 	const int dataBlocksCount = Size(dataBlocks);
+	int errorsCorrected = 0;
 	for (int j = 0; j < dataBlocksCount; j++) {
 		auto& [numDataCodewords, codewords] = dataBlocks[j];
-		if (!CorrectErrors(codewords, numDataCodewords)) {
+		int numErrors = 0;
+		if (!CorrectErrors(codewords, numDataCodewords, numErrors)) {
 			if(version->versionNumber == 24 && !fix259) {
 				fix259 = true;
 				goto retry;
 			}
 			return ChecksumError();
 		}
+		errorsCorrected += numErrors;
 
 		for (int i = 0; i < numDataCodewords; i++) {
 			// De-interlace data blocks.
@@ -437,7 +441,9 @@ retry:
 
 	// Decode the contents of that stream of bytes
 	return DecodedBitStreamParser::Decode(std::move(resultBytes), version->isDMRE())
-		.setVersionNumber(version->versionNumber);
+		.setVersionNumber(version->versionNumber)
+		.setEcCodewords(Size(codewords) - Size(resultBytes))
+		.setErrorsCorrected(errorsCorrected);
 }
 
 static BitMatrix FlippedL(const BitMatrix& bits)
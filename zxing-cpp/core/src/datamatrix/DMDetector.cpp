@@ -25,6 +25,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <map>
+#include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -509,7 +511,7 @@ public:
 
 		setDirectionInward(_points.back() - *maxP);
 
-		_points.resize(std::distance(_points.begin(), maxP) - 1);
+		resize(std::distance(_points.begin(), maxP) - 1);
 
 		return true;
 	}
@@ -858,64 +860,82 @@ static DetectorResult Scan(EdgeTracer& startTracer, std::array<DMRegressionLine,
 	return {};
 }
 
-static DetectorResults DetectNew(const BitMatrix& image, bool tryHarder, bool tryRotate)
+// Runs the edge tracer based detection along a set of scan lines starting in the center of the image and reports one symbol
+// per call of next(). Written as an explicit state machine so that it works without coroutine support as well.
+class NewDetector
 {
-#ifdef PRINT_DEBUG
-	LogMatrixWriter lmw(log, image, 1, "dm-log.pnm");
-//	tryRotate = tryHarder = false;
-#endif
+	static constexpr int minSymbolSize = 8 * 2; // minimum realistic size in pixel: 8 modules x 2 pixels per module
+	static constexpr std::array<PointF, 4> dirs = {PointF{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
 
-	// disable expensive multi-line scan to detect off-center symbols for now
-#ifndef __cpp_impl_coroutine
-	tryHarder = false;
+#ifdef PRINT_DEBUG
+	LogMatrixWriter lmw;
 #endif
+	const BitMatrix& _image;
+	bool _tryHarder, _tryRotate;
 
 	// a history log to remember where the tracing already passed by to prevent a later trace from doing the same work twice
-	ByteMatrix history;
-	if (tryHarder)
-		history = ByteMatrix(image.width(), image.height());
+	ByteMatrix _history;
 
 	// instantiate RegressionLine objects outside of Scan function to prevent repetitive std::vector allocations
-	std::array<DMRegressionLine, 4> lines;
+	std::array<DMRegressionLine, 4> _lines;
 
-	constexpr int minSymbolSize = 8 * 2; // minimum realistic size in pixel: 8 modules x 2 pixels per module
+	std::optional<EdgeTracer> _tracer;
+	int _dir = 0, _line = 0;
 
-	for (auto dir : {PointF{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
-		auto center = PointI(image.width() / 2, image.height() / 2);
-		auto startPos = centered(center - center * dir + minSymbolSize / 2 * dir);
+	bool nextTracer()
+	{
+		while (_dir < (_tryRotate ? Size(dirs) : 1)) { // only test left direction if !tryRotate
+			auto dir = dirs[_dir];
+			if (_line == 0)
+				_history.clear();
+
+			// if !tryHarder, only test center lines
+			if (_line == 0 || _tryHarder) {
+				auto center = PointI(_image.width() / 2, _image.height() / 2);
+				auto startPos = centered(center - center * dir + minSymbolSize / 2 * dir);
+				int i = ++_line;
+
+				_tracer.emplace(_image, startPos, dir);
+				_tracer->p += i / 2 * minSymbolSize * (i & 1 ? -1 : 1) * _tracer->right();
+				if (_tryHarder)
+					_tracer->history = &_history;
+
+				if (_tracer->isIn())
+					return true;
+			}
 
-		history.clear();
+			_tracer.reset();
+			++_dir;
+			_line = 0;
+		}
+		return false;
+	}
 
-		for (int i = 1;; ++i) {
-			EdgeTracer tracer(image, startPos, dir);
-			tracer.p += i / 2 * minSymbolSize * (i & 1 ? -1 : 1) * tracer.right();
-			if (tryHarder)
-				tracer.history = &history;
+public:
+	NewDetector(const BitMatrix& image, bool tryHarder, bool tryRotate)
+		:
+#ifdef PRINT_DEBUG
+		  lmw(log, image, 1, "dm-log.pnm"),
+#endif
+		  _image(image), _tryHarder(tryHarder), _tryRotate(tryRotate)
+	{
+		if (tryHarder)
+			_history = ByteMatrix(image.width(), image.height());
+	}
 
-			if (!tracer.isIn())
-				break;
+	NewDetector(const NewDetector&) = delete; // _tracer points to _history
+	NewDetector& operator=(const NewDetector&) = delete;
 
-#ifdef __cpp_impl_coroutine
-			DetectorResult res;
-			while (res = Scan(tracer, lines), res.isValid())
-				co_yield std::move(res);
-#else
-			if (auto res = Scan(tracer, lines); res.isValid())
+	DetectorResult next()
+	{
+		while (_tracer || nextTracer()) {
+			if (auto res = Scan(*_tracer, _lines); res.isValid())
 				return res;
-#endif
-
-			if (!tryHarder)
-				break; // only test center lines
+			_tracer.reset();
 		}
-
-		if (!tryRotate)
-			break; // only test left direction
+		return {};
 	}
-
-#ifndef __cpp_impl_coroutine
-	return {};
-#endif
-}
+};
 
 /**
 * This method detects a code in a "pure" image -- that is, pure monochrome image
@@ -966,7 +986,8 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 		co_yield std::move(r);
 	else if (!isPure) { // If r.isValid() then there is no point in looking for more (no-pure) symbols
 		bool found = false;
-		for (auto&& r : DetectNew(image, tryHarder, tryRotate)) {
+		NewDetector detector(image, tryHarder, tryRotate);
+		for (DetectorResult r; r = detector.next(), r.isValid();) {
 			found = true;
 			co_yield std::move(r);
 		}
@@ -976,12 +997,30 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 		}
 	}
 #else
-	auto result = DetectPure(image);
-	if (!result.isValid() && !isPure)
-		result = DetectNew(image, tryHarder, tryRotate);
-	if (!result.isValid() && tryHarder && !isPure)
-		result = DetectOld(image);
-	return result;
+	// same sequence as above, written as a state machine
+	auto pure = DetectPure(image);
+	if (pure.isValid() || isPure)
+		return DetectorResults([r = std::move(pure)]() mutable -> std::optional<DetectorResult> {
+			if (!r.isValid())
+				return {};
+			return std::exchange(r, {});
+		});
+
+	auto detector = std::make_unique<NewDetector>(image, tryHarder, tryRotate);
+	return DetectorResults([&image, tryHarder, found = false,
+							detector = std::move(detector)]() mutable -> std::optional<DetectorResult> {
+		if (!detector)
+			return {};
+		if (auto r = detector->next(); r.isValid()) {
+			found = true;
+			return r;
+		}
+		detector.reset();
+		if (!found && tryHarder)
+			if (auto r = DetectOld(image); r.isValid())
+				return r;
+		return {};
+	});
 #endif
 }
 
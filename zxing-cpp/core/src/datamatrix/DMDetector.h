@@ -6,10 +6,8 @@
 
 #pragma once
 
-#ifdef __cpp_impl_coroutine
 #include <Generator.h>
 #include <DetectorResult.h>
-#endif
 
 namespace ZXing {
 
@@ -18,11 +16,7 @@ class DetectorResult;
 
 namespace DataMatrix {
 
-#ifdef __cpp_impl_coroutine
 using DetectorResults = Generator<DetectorResult>;
-#else
-using DetectorResults = DetectorResult;
-#endif
 
 DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure);
 
@@ -45,6 +45,12 @@ bool IsLeftGuard(const PatternView& view, int spaceInPixel)
 		   Contains({0x1A, 0x29, 0x0B, 0x0E}, RowReader::NarrowWideBitPattern(view));
 }
 
+// IsLeftGuard: space > QUIET_ZONE_SCALE * sum of the CHAR_LEN (7) elements >= 0.5 * (bar + 6) => space >= 0.5 * bar + 3
+std::optional<RowReader::LeftGuardBound> CodabarReader::leftGuardBound() const
+{
+	return LeftGuardBound{0.5f, -3, 4 * CHAR_LEN}; // see minCharCount below
+}
+
 Barcode CodabarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop and checksum characters)
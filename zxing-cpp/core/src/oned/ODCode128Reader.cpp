@@ -160,27 +160,29 @@ constexpr int CHAR_LEN = 6;
 constexpr float QUIET_ZONE = 5;	// quiet zone spec is 10 modules, real world examples ignore that, see #138
 constexpr int CHAR_MODS = 11;
 
-//TODO: make this a constexpr variable initialization
-static auto E2E_PATTERNS = [] {
-	// This creates an array of ints for fast IndexOf lookup of the edge-2-edge patterns (ISO/IEC 15417:2007(E) Table 2)
-	// e.g. a code pattern of { 2, 1, 2, 2, 2, 2 } becomes the e2e pattern { 3, 3, 4, 4 } and the value 0b11100011110000.
-	std::array<int, 107> res;
-	for (int i = 0; i < Size(res); ++i) {
-		const auto& a = Code128::CODE_PATTERNS[i];
-		std::array<int, 4> e2e;
-		for (int j = 0; j < 4; j++)
-			e2e[j] = a[j] + a[j + 1];
-		res[i] = ToInt(e2e);
-	}
-	return res;
-}();
+// Maps the edge-2-edge patterns (ISO/IEC 15417:2007(E) Table 2) to their code, e.g. a code pattern of { 2, 1, 2, 2, 2, 2 }
+// becomes the e2e pattern { 3, 3, 4, 4 } and the key 0b11100011110000.
+static constexpr auto E2E_PATTERNS = PatternIndex<107>(Code128::CODE_PATTERNS, [](const auto& a) {
+	std::array<int, 4> e2e = {};
+	for (int j = 0; j < 4; j++)
+		e2e[j] = a[j] + a[j + 1];
+	return ToInt(e2e);
+});
+static_assert(E2E_PATTERNS.isValid(), "Code128 e2e patterns are not unique");
+
+// START_PATTERN_PREFIX: space >= QUIET_ZONE * m - 1 and bar <= 2.5 * m + 0.5 (see IsPattern) => space >= 2 * bar - 2,
+// the bound uses an offset of 3 instead of 2 to leave some slack
+std::optional<RowReader::LeftGuardBound> Code128Reader::leftGuardBound() const
+{
+	return LeftGuardBound{2, 3, 4 * CHAR_LEN}; // see minCharCount below
+}
 
 Barcode Code128Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
 {
 	int minCharCount = 4; // start + payload + checksum + stop
 	auto decodePattern = [](const PatternView& view, bool start = false) {
 		// This is basically the reference algorithm from the specification
-		int code = IndexOf(E2E_PATTERNS, ToInt(NormalizedE2EPattern<CHAR_LEN>(view, CHAR_MODS)));
+		int code = E2E_PATTERNS.indexOf(ToInt(NormalizedE2EPattern<CHAR_LEN>(view, CHAR_MODS)));
 		if (code == -1 && !start) // if the reference algo fails, give the original upstream version a try (required to decode a few samples)
 			code = DecodeDigit(view, Code128::CODE_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE);
 		return code;
@@ -73,6 +73,12 @@ std::string DecodeCode39AndCode93FullASCII(std::string encoded, const char ctrl[
 	return encoded;
 }
 
+// START_PATTERN: space >= 6 * m - 1 and bar <= 1.5 * m + 0.5 (see IsPattern) => space >= 4 * bar - 3
+std::optional<RowReader::LeftGuardBound> Code39Reader::leftGuardBound() const
+{
+	return LeftGuardBound{4, 4, 3 * CHAR_LEN}; // see minCharCount below
+}
+
 Barcode Code39Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop and checksum characters)
@@ -25,7 +25,7 @@ static const char ALPHABET[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. $/+%abcd*
 * The 9 least-significant bits of each int correspond to the 9 modules in a symbol.
 * Note: bit 9 (the first) is always 1, bit 1 (the last) is always 0.
 */
-static const int CHARACTER_ENCODINGS[] = {
+static constexpr int CHARACTER_ENCODINGS[] = {
 	0x114, 0x148, 0x144, 0x142, 0x128, 0x124, 0x122, 0x150, 0x112, 0x10A, // 0-9
 	0x1A8, 0x1A4, 0x1A2, 0x194, 0x192, 0x18A, 0x168, 0x164, 0x162, 0x134, // A-J
 	0x11A, 0x158, 0x14C, 0x146, 0x12C, 0x116, 0x1B4, 0x1B2, 0x1AC, 0x1A6, // K-T
@@ -36,6 +36,9 @@ static const int CHARACTER_ENCODINGS[] = {
 
 static_assert(Size(ALPHABET) - 1 == Size(CHARACTER_ENCODINGS), "table size mismatch");
 
+static constexpr auto CHARACTER_INDEX = PatternIndex<Size(CHARACTER_ENCODINGS)>(CHARACTER_ENCODINGS);
+static_assert(CHARACTER_INDEX.isValid(), "Code93 character encodings are not unique");
+
 static const int ASTERISK_ENCODING = 0x15E;
 
 using CounterContainer = std::array<int, 6>;
@@ -80,6 +83,12 @@ static bool IsStartGuard(const PatternView& window, int spaceInPixel)
 		   RowReader::OneToFourBitPattern<CHAR_LEN, CHAR_SUM>(window) == ASTERISK_ENCODING;
 }
 
+// IsStartGuard: space >= 6 * m - 1 and bar <= 1.5 * m + 0.5 (see IsPattern) => space >= 4 * bar - 3
+std::optional<RowReader::LeftGuardBound> Code93Reader::leftGuardBound() const
+{
+	return LeftGuardBound{4, 4, 5 * CHAR_LEN}; // see minCharCount below
+}
+
 Barcode Code93Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop, checksum and 1 payload characters)
@@ -99,7 +108,7 @@ Barcode Code93Reader::decodePattern(int rowNumber, PatternView& next, std::uniqu
 		if (!next.skipSymbol())
 			return {};
 
-		txt += LookupBitPattern(OneToFourBitPattern<CHAR_LEN, CHAR_SUM>(next), CHARACTER_ENCODINGS, ALPHABET);
+		txt += LookupBitPattern(OneToFourBitPattern<CHAR_LEN, CHAR_SUM>(next), CHARACTER_INDEX, ALPHABET);
 		if (txt.back() == 0)
 			return {};
 	} while (txt.back() != '*');
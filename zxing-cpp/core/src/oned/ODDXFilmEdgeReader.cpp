@@ -104,6 +104,11 @@ std::optional<Clock> CheckForClock(int rowNumber, PatternView& view)
 
 } // namespace
 
+int DXFilmEdgeReader::minRowSize() const
+{
+	return 10; // see FindLeftGuard() below
+}
+
 Barcode DXFilmEdgeReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
 {
 	if (!state) {
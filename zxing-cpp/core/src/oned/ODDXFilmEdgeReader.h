@@ -21,6 +21,8 @@ public:
 	using RowReader::RowReader;
 
 	Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const override;
+	bool usesDecodingState() const override { return true; }
+	int minRowSize() const override;
 };
 
 } // namespace ZXing::OneD
@@ -152,18 +152,31 @@ bool ReadDataCharacterRaw(const PatternView& view, int numModules, bool reversed
 #endif
 }
 
+// pairs found in a reversed row have mirrored x coordinates (xStart > xStop), see PatternView::reversedRow()
+static bool IsMirrored(const Pair& p)
+{
+	return p.xStart > p.xStop;
+}
+
 static bool IsStacked(const Pair& first, const Pair& last)
 {
-	// check if we see two halfes that are far away from each other in y or overlapping in x
-	return std::abs(first.y - last.y) > (first.xStop - first.xStart) || last.xStart < (first.xStart + first.xStop) / 2;
+	// check if we see two halfes that were read in opposite directions (i.e. in different rows), that are far away from
+	// each other in y or that are overlapping in x
+	int dir = IsMirrored(first) ? -1 : 1;
+	return IsMirrored(first) != IsMirrored(last) || std::abs(first.y - last.y) > dir * (first.xStop - first.xStart) ||
+		   dir * last.xStart < dir * (first.xStart + first.xStop) / 2;
 }
 
 Position EstimatePosition(const Pair& first, const Pair& last)
 {
 	if (!IsStacked(first, last))
 		return Line((first.y + last.y) / 2, first.xStart, last.xStop);
-	else
-		return Position{{first.xStart, first.y}, {first.xStop, first.y}, {last.xStop, last.y}, {last.xStart, last.y}};
+
+	// the last pair is oriented like the first one, even if its row was read in the opposite direction
+	bool flip = IsMirrored(first) != IsMirrored(last);
+	int lastStart = flip ? last.xStop : last.xStart;
+	int lastStop = flip ? last.xStart : last.xStop;
+	return Position{{first.xStart, first.y}, {first.xStop, first.y}, {lastStop, last.y}, {lastStart, last.y}};
 }
 
 int EstimateLineCount(const Pair& first, const Pair& last)
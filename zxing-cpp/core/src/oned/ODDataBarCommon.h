@@ -114,13 +114,21 @@ struct PairHash
 constexpr int FULL_PAIR_SIZE = 8 + 5 + 8;
 constexpr int HALF_PAIR_SIZE = 8 + 5 + 2; // half has to be followed by a guard pattern
 
+template <int N>
+constexpr PatternIndex<N> FinderPatternIndex(const std::array<std::array<int, 3>, N>& e2ePatterns)
+{
+	return PatternIndex<N>(e2ePatterns, [](const auto& e2e) { return ToInt(e2e); });
+}
+
 template<int N>
-int ParseFinderPattern(const PatternView& view, bool reversed, const std::array<std::array<int, 3>, N>& e2ePatterns)
+int ParseFinderPattern(const PatternView& view, bool reversed, const std::array<std::array<int, 3>, N>& e2ePatterns,
+					   const PatternIndex<N>& e2eIndex)
 {
 	const auto e2e = NormalizedE2EPattern<5>(view, 15, reversed);
 
-	int best_i, best_e = 3;
-	for (int i = 0; i < Size(e2ePatterns); ++i) {
+	// an exact match is always the best one, only otherwise look for a pattern that is off by one module
+	int best_i = e2eIndex.indexOf(ToInt(e2e)), best_e = best_i == -1 ? 3 : 0;
+	for (int i = 0; i < Size(e2ePatterns) && best_e; ++i) {
 		int e = 0;
 		for (int j = 0; j < 3; ++j)
 			e += std::abs(e2ePatterns[i][j] - e2e[j]);
@@ -13,7 +13,12 @@
 #include "ODDataBarCommon.h"
 #include "ODDataBarExpandedBitDecoder.h"
 #include "Barcode.h"
+#include "ZXConfig.h"
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
 #include <cmath>
 #include <map>
 #include <vector>
@@ -133,6 +138,8 @@ static const std::array<std::vector<int>, 10> FINDER_PATTERN_SEQUENCES = {{
 	{FINDER_A, -FINDER_A, FINDER_B, -FINDER_B, FINDER_C, -FINDER_D, FINDER_D, -FINDER_E, FINDER_E, -FINDER_F, FINDER_F},
 }};
 
+constexpr int MAX_SEQUENCE_LEN = 11; // of the FINDER_PATTERN_SEQUENCES
+
 static const std::array<int, 7> VALID_HALF_PAIRS = {{-FINDER_A, FINDER_B, -FINDER_D, FINDER_C, -FINDER_F, FINDER_F, FINDER_E}};
 
 static int ParseFinderPattern(const PatternView& view, Direction dir)
@@ -146,10 +153,13 @@ static int ParseFinderPattern(const PatternView& view, Direction dir)
 		{4, 11, 10}, // {2, 2, 9, 1, 1}, // F
 	}};
 
-	return ParseFinderPattern<6>(view, dir == Direction::Left, e2ePatterns);
+	static constexpr auto e2eIndex = FinderPatternIndex<6>(e2ePatterns);
+	static_assert(e2eIndex.isValid(), "finder patterns are not unique");
+
+	return ParseFinderPattern<6>(view, dir == Direction::Left, e2ePatterns, e2eIndex);
 }
 
-static bool ChecksumIsValid(const Pairs& pairs)
+[[maybe_unused]] static bool ChecksumIsValid(const Pairs& pairs)
 {
 	auto checksum = TransformReduce(pairs, 0, [](auto p) { return p.left.checksum + p.right.checksum; }) % 211 +
 					211 * (2 * Size(pairs) - 4 - !pairs.back().right);
@@ -232,8 +242,6 @@ static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
 	return pairs;
 }
 
-using PairMap = std::map<int, Pairs>;
-
 // inserts all pairs inside row into the PairMap or increases their count respectively.
 static bool Insert(PairMap& all, Pairs&& row)
 {
@@ -254,51 +262,82 @@ static bool Insert(PairMap& all, Pairs&& row)
 	return res;
 }
 
-template <typename ITER>
-static bool FindValidSequence(const PairMap& all, ITER begin, ITER end, Pairs& stack)
+// Returns the first sequence of pairs starting with first (in the order of the candidates, see below) that matches the
+// finder sequence encoded in first and has a valid checksum, or an empty list.
+//
+// Only the N most common pairs for each finder are candidates. Instead of a depth-first search over all combinations
+// of candidates (N^10 evaluations of ChecksumIsValid() in the worst case), the search runs in two passes over the
+// sequence: back to front, reach[i] collects the checksum residues (mod 211) that the candidates for positions i.. can
+// add up to. Front to back, the first candidate for position i is picked, with which the remaining positions can still
+// reach the required residue. The result is the same as that of the depth-first search but the cost is linear in the
+// length of the sequence and N.
+static Pairs CompleteSequence(const PairMap& all, const Pair& first)
 {
-	if (begin == end)
-		return ChecksumIsValid(stack);
-
-	if (auto ppairs = all.find(*begin); ppairs != all.end()) {
-		// only try the N most common pairs, this means the absolute maximum number of ChecksumIsValid() evaluations
-		// is N^11 (11 is the maximum sequence length).
-		constexpr int N = 2;
-		// TODO c++20 ranges::views::take()
+	// to lower the chance of a misread, only the N most common pairs are candidates for each finder
+	constexpr int N = 2;
+	using Residues = std::bitset<211>;
+
+	auto checksum = [](const Pair& p) { return (p.left.checksum + p.right.checksum) % 211; };
+	auto rotate = [](const Residues& r, int n) { return n ? (r << n) | (r >> (211 - n)) : r; };
+
+	const auto& sequence = FINDER_PATTERN_SEQUENCES[SequenceIndex(first.left)];
+	const int len = Size(sequence);
+	if (len > MAX_SEQUENCE_LEN)
+		return {};
+	// the last pair is a half-pair if the number of data characters is odd, see ChecksumIsValid()
+	const bool lastIsHalfPair = first.left.value / 211 == 2 * len - 5;
+
+	std::array<std::array<const Pair*, N>, MAX_SEQUENCE_LEN> candidates = {};
+	std::array<int, MAX_SEQUENCE_LEN> counts = {};
+	for (int i = 1; i < len; ++i) {
+		auto ppairs = all.find(sequence[i]);
+		if (ppairs == all.end())
+			return {};
 		auto& pairs = ppairs->second;
-		int n = 0;
-		for (auto p = pairs.begin(), pend = pairs.end(); p != pend && n < N; ++p, ++n) {
-			// skip p if it is a half-pair but not the last one in the sequence
-			if (!p->right && std::next(begin) != end)
-				continue;
-			// to lower the chance of a misread, one can require each pair to have been seen at least N times.
-			// e.g: if (p.count < 2) break;
-			stack.push_back(*p);
-			if (FindValidSequence(all, std::next(begin), end, stack))
-				return true;
-			stack.pop_back();
-		}
+		for (int n = 0; n < std::min(N, Size(pairs)); ++n)
+			// half-pairs can only be the last one in the sequence
+			if (!pairs[n].right == (i == len - 1 && lastIsHalfPair))
+				candidates[i][counts[i]++] = &pairs[n];
 	}
 
-	return false;
+	std::array<Residues, MAX_SEQUENCE_LEN + 1> reach = {};
+	reach[len].set(0);
+	for (int i = len - 1; i > 0; --i)
+		for (int n = 0; n < counts[i]; ++n)
+			reach[i] |= rotate(reach[i + 1], checksum(*candidates[i][n]));
+
+	int residue = ((first.left.value % 211 - checksum(first)) % 211 + 211) % 211;
+	if (!reach[1][residue])
+		return {};
+
+	Pairs res = {first};
+	for (int i = 1; i < len; ++i)
+		for (int n = 0; n < counts[i]; ++n) {
+			int rest = (residue - checksum(*candidates[i][n]) + 211) % 211;
+			if (reach[i + 1][rest]) {
+				res.push_back(*candidates[i][n]);
+				residue = rest;
+				break;
+			}
+		}
+
+	assert(Size(res) == len && ChecksumIsValid(res));
+	return res;
 }
 
-static Pairs FindValidSequence(PairMap& all)
+Pairs DataBar::FindValidSequence(PairMap& all)
 {
-	Pairs stack;
 	for (const auto& first : all[FINDER_A]) {
-		int sequenceIndex = SequenceIndex(first.left);
+		// ReadPair() only returns FINDER_A pairs with a valid sequence index but all may come from anywhere
+		if (!ChecksumIsValid(first.left))
+			continue;
 		// if we have not seen enough pairs to possibly complete the sequence, wait for more
-		if (Size(all) < sequenceIndex + 2)
+		if (Size(all) < SequenceIndex(first.left) + 2)
 			continue;
-		auto& sequence = FINDER_PATTERN_SEQUENCES[sequenceIndex];
-		stack.push_back(first);
-		// recursively fill the stack with pairs according to the valid finder sequence
-		if (FindValidSequence(all, std::next(std::begin(sequence)), std::end(sequence), stack))
-			break;
-		stack.pop_back();
+		if (auto res = CompleteSequence(all, first); !res.empty())
+			return res;
 	}
-	return stack;
+	return {};
 }
 
 static void RemovePairs(PairMap& all, const Pairs& pairs)
@@ -326,8 +365,25 @@ static BitArray BuildBitArray(const Pairs& pairs)
 struct DBERState : public RowReader::DecodingState
 {
 	PairMap allPairs;
+
+	void forgetRowsBefore(int rowNumber) override
+	{
+		for (auto i = allPairs.begin(); i != allPairs.end();) {
+			auto& pairs = i->second;
+			pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [rowNumber](const Pair& p) { return p.y < rowNumber; }),
+						pairs.end());
+			// FindValidSequence() looks at the number of finders seen so far
+			i = pairs.empty() ? allPairs.erase(i) : std::next(i);
+		}
+	}
 };
 
+// ReadRowOfPairs<true>() needs room for at least a half pair behind the first bar
+int DataBarExpandedReader::minRowSize() const
+{
+	return HALF_PAIR_SIZE + 1;
+}
+
 Barcode DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view, std::unique_ptr<RowReader::DecodingState>& state) const
 {
 #if 0 // non-stacked version
@@ -353,7 +409,24 @@ Barcode DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view, s
 	//    r l r l    |    r l     |     r l r
 	//    L R L R    |    r       |     l
 
-	if (!Insert(allPairs, ReadRowOfPairs<true>(view, rowNumber)))
+	// upside down symbols are found by looking at the row from the other end as well. this is done once per row, when
+	// the row scan starts at the first bar, and it covers all pairs in the reversed row. their x coordinates are mirrored,
+	// so all pairs in allPairs share the same coordinate system.
+	bool inserted = false;
+	if (view.isAtFirstBar()) {
+		ZX_THREAD_LOCAL PatternRow reversed;
+		int mirror = view.rowWidth() - 1;
+		for (auto next = view.reversedRow(reversed); next.size(); next.shift(2 - (next.index() % 2)), next.extend()) {
+			auto pairs = ReadRowOfPairs<true>(next, rowNumber);
+			for (auto& p : pairs) {
+				p.xStart = mirror - p.xStart;
+				p.xStop = mirror - p.xStop;
+			}
+			inserted |= Insert(allPairs, std::move(pairs));
+		}
+	}
+
+	if (!Insert(allPairs, ReadRowOfPairs<true>(view, rowNumber)) && !inserted)
 		return {};
 
 	auto pairs = FindValidSequence(allPairs);
@@ -7,10 +7,26 @@
 
 #pragma once
 
+#include "ODDataBarCommon.h"
 #include "ODRowReader.h"
 
+#include <map>
+#include <vector>
+
 namespace ZXing::OneD {
 
+namespace DataBar {
+
+using PairMap = std::map<int, std::vector<Pair>>; // all pairs seen so far by their finder, the most common ones first
+
+/**
+* Returns the pairs of a symbol with a valid finder sequence and checksum, starting with a FINDER_A pair in all, or an
+* empty list. The cost is linear in the number of pairs in all.
+*/
+std::vector<Pair> FindValidSequence(PairMap& all);
+
+} // namespace DataBar
+
 /**
 * Decodes DataBarExpandedReader (formerly known as RSS) sybmols, including truncated and stacked variants. See ISO/IEC 24724:2006.
 */
@@ -20,6 +36,9 @@ public:
 	using RowReader::RowReader;
 
 	Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	bool usesDecodingState() const override { return true; }
+	bool decodesBothDirections() const override { return true; }
+	int minRowSize() const override;
 };
 
 } // namespace ZXing::OneD
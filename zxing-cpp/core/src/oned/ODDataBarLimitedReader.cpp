@@ -90,7 +90,7 @@ static inline bool Has26to18Ratio(int v26, int v18)
 	return v26 + 1.5 * v26 / 26 > v18 / 18. * 26. && v26 - 1.5 * v26 / 26 < v18 / 18. * 26.;
 }
 
-std::array<int, 89> CheckChars = {
+static constexpr std::array<int, 89> CheckChars = {
 	0b10'10101010'11100010, 0b10'10101010'01110010, 0b10'10101010'00111010, 0b10'10101001'01110010, 0b10'10101001'00111010,
 	0b10'10101000'10111010, 0b10'10100101'01110010, 0b10'10100101'00111010, 0b10'10100100'10111010, 0b10'10100010'10111010,
 	0b10'10010101'01110010, 0b10'10010101'00111010, 0b10'10010100'10111010, 0b10'10010010'10111010, 0b10'10001010'10111010,
@@ -111,6 +111,14 @@ std::array<int, 89> CheckChars = {
 	0b11'01010010'10011010, 0b11'01010010'01011010, 0b11'01001010'10011010, 0b11'01010101'10010010,
 };
 
+static constexpr auto CheckCharsIndex = PatternIndex<89>(CheckChars);
+static_assert(CheckCharsIndex.isValid(), "check character patterns are not unique");
+
+int DataBarLimitedReader::minRowSize() const
+{
+	return SYMBOL_LEN;
+}
+
 Barcode DataBarLimitedReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	next = next.subView(-2, SYMBOL_LEN);
@@ -138,7 +146,7 @@ Barcode DataBarLimitedReader::decodePattern(int rowNumber, PatternView& next, st
 			continue;
 
 		auto checkCharPattern = ToInt(NormalizedPatternFromE2E<CHAR_LEN>(checkView, 18));
-		int checkSum = IndexOf(CheckChars, checkCharPattern);
+		int checkSum = CheckCharsIndex.indexOf(checkCharPattern);
 		if (checkSum == -1)
 			continue;
 
@@ -18,6 +18,7 @@ public:
 	using RowReader::RowReader;
 
 	Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	int minRowSize() const override;
 };
 
 } // namespace ZXing::OneD
@@ -13,8 +13,10 @@
 #include "GTIN.h"
 #include "ODDataBarCommon.h"
 #include "Barcode.h"
+#include "ZXConfig.h"
 
 #include <cmath>
+#include <iterator>
 #include <unordered_set>
 
 namespace ZXing::OneD {
@@ -98,7 +100,10 @@ int ParseFinderPattern(const PatternView& view, bool reversed)
 		{4 , 12, 10}, // {1, 3, 9, 1, 1}
 	}};
 
-	return ParseFinderPattern<9>(view, reversed, e2ePatterns);
+	static constexpr auto e2eIndex = FinderPatternIndex<9>(e2ePatterns);
+	static_assert(e2eIndex.isValid(), "finder patterns are not unique");
+
+	return ParseFinderPattern<9>(view, reversed, e2ePatterns, e2eIndex);
 }
 
 static Pair ReadPair(const PatternView& view, bool rightPair)
@@ -147,8 +152,52 @@ struct State : public RowReader::DecodingState
 {
 	std::unordered_set<Pair, PairHash> leftPairs;
 	std::unordered_set<Pair, PairHash> rightPairs;
+
+	void forgetRowsBefore(int rowNumber) override
+	{
+		for (auto* pairs : {&leftPairs, &rightPairs})
+			for (auto i = pairs->begin(); i != pairs->end();)
+				i = i->y < rowNumber ? pairs->erase(i) : std::next(i);
+	}
 };
 
+// inserts all pairs of the row into the state. if mirror != 0, the x coordinates are mapped to mirror - x.
+static void ReadPairs(PatternView& next, int rowNumber, int mirror, State& state)
+{
+	auto insert = [&](auto& pairs, Pair pair) {
+		pair.y = rowNumber;
+		if (mirror) {
+			pair.xStart = mirror - pair.xStart;
+			pair.xStop = mirror - pair.xStop;
+		}
+		pairs.insert(pair);
+	};
+
+	next = next.subView(0, FULL_PAIR_SIZE + 1); // +1 reflects the guard pattern on the right, see IsRightPair()
+	// yes: the first view we test is at index 1 (black bar at 0 would be the guard pattern)
+	while (next.shift(1)) {
+		if (IsLeftPair(next)) {
+			if (auto leftPair = ReadPair(next, false)) {
+				insert(state.leftPairs, leftPair);
+				next.shift(FULL_PAIR_SIZE - 1);
+			}
+		}
+
+		if (next.shift(1) && IsRightPair(next)) {
+			if (auto rightPair = ReadPair(next, true)) {
+				insert(state.rightPairs, rightPair);
+				next.shift(FULL_PAIR_SIZE + 2);
+			}
+		}
+	}
+}
+
+// ReadPairs() needs room for a full pair plus the guard on its right behind the first bar
+int DataBarReader::minRowSize() const
+{
+	return FULL_PAIR_SIZE + 2;
+}
+
 Barcode DataBarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>& state) const
 {
 #if 0 // non-stacked version
@@ -169,25 +218,15 @@ Barcode DataBarReader::decodePattern(int rowNumber, PatternView& next, std::uniq
 		state.reset(new State);
 	auto* prevState = static_cast<State*>(state.get());
 
-	next = next.subView(0, FULL_PAIR_SIZE + 1); // +1 reflects the guard pattern on the right, see IsRightPair()
-	// yes: the first view we test is at index 1 (black bar at 0 would be the guard pattern)
-	while (next.shift(1)) {
-		if (IsLeftPair(next)) {
-			if (auto leftPair = ReadPair(next, false)) {
-				leftPair.y = rowNumber;
-				prevState->leftPairs.insert(leftPair);
-				next.shift(FULL_PAIR_SIZE - 1);
-			}
-		}
-
-		if (next.shift(1) && IsRightPair(next)) {
-			if (auto rightPair = ReadPair(next, true)) {
-				rightPair.y = rowNumber;
-				prevState->rightPairs.insert(rightPair);
-				next.shift(FULL_PAIR_SIZE + 2);
-			}
-		}
+	// look at the row in both directions to find upside down symbols. the reversed row is read once, when the row scan
+	// starts at the first bar. pairs found in there get their x coordinates mirrored, so all pairs in the state share
+	// the same coordinate system.
+	if (next.isAtFirstBar()) {
+		ZX_THREAD_LOCAL PatternRow reversed;
+		auto view = next.reversedRow(reversed);
+		ReadPairs(view, rowNumber, next.rowWidth() - 1, *prevState);
 	}
+	ReadPairs(next, rowNumber, 0, *prevState);
 
 	for (const auto& leftPair : prevState->leftPairs)
 		for (const auto& rightPair : prevState->rightPairs)
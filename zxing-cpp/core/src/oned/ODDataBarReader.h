@@ -20,6 +20,9 @@ public:
 	using RowReader::RowReader;
 
 	Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	bool usesDecodingState() const override { return true; }
+	bool decodesBothDirections() const override { return true; }
+	int minRowSize() const override;
 };
 
 } // namespace ZXing::OneD
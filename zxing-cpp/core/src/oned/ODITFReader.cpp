@@ -13,6 +13,12 @@
 
 namespace ZXing::OneD {
 
+// start pattern: space >= 6 * m - 1 and bar <= 1.5 * m + 0.5 (see IsPattern) => space >= 4 * bar - 3
+std::optional<RowReader::LeftGuardBound> ITFReader::leftGuardBound() const
+{
+	return LeftGuardBound{4, 4, 4 + 4 / 2 + 3}; // see minCharCount below
+}
+
 Barcode ITFReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
 {
 	const int minCharCount = _opts.formats().count() == 1 ? 4 : 6; // if we are only looking for ITF, we accept shorter symbols
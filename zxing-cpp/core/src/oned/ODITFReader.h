@@ -28,6 +28,7 @@ public:
 	using RowReader::RowReader;
 
 	Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const override;
+	std::optional<LeftGuardBound> leftGuardBound() const override;
 };
 
 } // namespace ZXing::OneD
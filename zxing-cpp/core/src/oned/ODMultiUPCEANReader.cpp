@@ -41,6 +41,9 @@ constexpr float QUIET_ZONE_ADDON = 3;
 // There is a single sample (ean13-1/12.png) that fails to decode with these (new) settings because
 // it has a right-side quiet zone of only about 4.5 modules, which is clearly out of spec.
 
+static constexpr auto L_AND_G_INDEX = PatternIndex<20>(UPCEANCommon::L_AND_G_PATTERNS, [](const auto& a) { return ToInt(a); });
+static_assert(L_AND_G_INDEX.isValid(), "UPC/EAN digit patterns are not unique");
+
 static bool DecodeDigit(const PatternView& view, std::string& txt, int* lgPattern = nullptr)
 {
 #if 1
@@ -50,9 +53,19 @@ static bool DecodeDigit(const PatternView& view, std::string& txt, int* lgPatter
 	static constexpr float MAX_AVG_VARIANCE = 0.48f;
 	static constexpr float MAX_INDIVIDUAL_VARIANCE = 0.7f;
 
-	int bestMatch =
-		lgPattern ? RowReader::DecodeDigit(view, UPCEANCommon::L_AND_G_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false)
-				  : RowReader::DecodeDigit(view, UPCEANCommon::L_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false);
+	// In the common case the rounded module widths are one of the digit patterns. If none of the elements is off by half
+	// a module or more, every other pattern has a larger variance (they differ in at least 2 elements by 1 module), so
+	// this is the match the search below would find. Only otherwise do we need to compare against all patterns.
+	int bestMatch = L_AND_G_INDEX.indexOf(ToInt(NormalizedPattern<CHAR_LEN, 7>(view)));
+	if (bestMatch >= (lgPattern ? 20 : 10)
+		|| (bestMatch != -1
+			&& RowReader::PatternMatchVariance(view, UPCEANCommon::L_AND_G_PATTERNS[bestMatch], 0.499f) >= MAX_AVG_VARIANCE))
+		bestMatch = -1;
+
+	if (bestMatch == -1)
+		bestMatch = lgPattern
+						? RowReader::DecodeDigit(view, UPCEANCommon::L_AND_G_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false)
+						: RowReader::DecodeDigit(view, UPCEANCommon::L_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false);
 	if (bestMatch == -1)
 		return false;
 
@@ -262,6 +275,12 @@ static bool AddOn(PartialResult& res, PatternView begin, int digitCount)
 	return true;
 }
 
+// END_PATTERN: space >= QUIET_ZONE_LEFT * m - 1 and bar <= 1.5 * m + 0.5 (see IsPattern) => space >= 4 * bar - 3
+std::optional<RowReader::LeftGuardBound> MultiUPCEANReader::leftGuardBound() const
+{
+	return LeftGuardBound{4, 4, 3 + 6*4 + 6}; // see minSize below
+}
+
 Barcode MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	const int minSize = 3 + 6*4 + 6; // UPC-E
@@ -9,24 +9,49 @@
 
 #include "BinaryBitmap.h"
 #include "ReaderOptions.h"
+#include "Barcode.h"
+#include "ZXThreads.h"
+
+#ifndef ZXING_DISABLE_CODABAR
 #include "ODCodabarReader.h"
+#endif
+#ifndef ZXING_DISABLE_CODE128
 #include "ODCode128Reader.h"
+#endif
+#ifndef ZXING_DISABLE_CODE39
 #include "ODCode39Reader.h"
+#endif
+#ifndef ZXING_DISABLE_CODE93
 #include "ODCode93Reader.h"
+#endif
+#ifndef ZXING_DISABLE_DATABAR
 #include "ODDataBarExpandedReader.h"
 #include "ODDataBarLimitedReader.h"
 #include "ODDataBarReader.h"
+#endif
+#ifndef ZXING_DISABLE_DXFILMEDGE
 #include "ODDXFilmEdgeReader.h"
+#endif
+#ifndef ZXING_DISABLE_ITF
 #include "ODITFReader.h"
+#endif
+#ifndef ZXING_DISABLE_EANUPC
 #include "ODMultiUPCEANReader.h"
-#include "Barcode.h"
+#endif
 
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #ifdef PRINT_DEBUG
 #include "BitMatrix.h"
 #include "BitMatrixIO.h"
+
+#include <cstdio>
 #endif
 
 namespace ZXing {
@@ -46,31 +71,270 @@ Reader::Reader(const ReaderOptions& opts) : ZXing::Reader(opts)
 
 	auto formats = opts.formats().empty() ? BarcodeFormat::Any : opts.formats();
 
+#ifndef ZXING_DISABLE_EANUPC
 	if (formats.testFlags(BarcodeFormat::EAN13 | BarcodeFormat::UPCA | BarcodeFormat::EAN8 | BarcodeFormat::UPCE))
 		_readers.emplace_back(new MultiUPCEANReader(opts));
+#endif
 
+#ifndef ZXING_DISABLE_CODE39
 	if (formats.testFlag(BarcodeFormat::Code39))
 		_readers.emplace_back(new Code39Reader(opts));
+#endif
+#ifndef ZXING_DISABLE_CODE93
 	if (formats.testFlag(BarcodeFormat::Code93))
 		_readers.emplace_back(new Code93Reader(opts));
+#endif
+#ifndef ZXING_DISABLE_CODE128
 	if (formats.testFlag(BarcodeFormat::Code128))
 		_readers.emplace_back(new Code128Reader(opts));
+#endif
+#ifndef ZXING_DISABLE_ITF
 	if (formats.testFlag(BarcodeFormat::ITF))
 		_readers.emplace_back(new ITFReader(opts));
+#endif
+#ifndef ZXING_DISABLE_CODABAR
 	if (formats.testFlag(BarcodeFormat::Codabar))
 		_readers.emplace_back(new CodabarReader(opts));
+#endif
+#ifndef ZXING_DISABLE_DATABAR
 	if (formats.testFlags(BarcodeFormat::DataBar))
 		_readers.emplace_back(new DataBarReader(opts));
 	if (formats.testFlags(BarcodeFormat::DataBarExpanded))
 		_readers.emplace_back(new DataBarExpandedReader(opts));
 	if (formats.testFlags(BarcodeFormat::DataBarLimited))
 		_readers.emplace_back(new DataBarLimitedReader(opts));
+#endif
+#ifndef ZXING_DISABLE_DXFILMEDGE
 	if (formats.testFlag(BarcodeFormat::DXFilmEdge))
 		_readers.emplace_back(new DXFilmEdgeReader(opts));
+#endif
 }
 
 Reader::~Reader() = default;
 
+// The bars of a row that could be the start of a left guard of any of the readers providing a LeftGuardBound. They are
+// collected in a single pass over the row instead of each reader scanning the whole row for its own guard.
+struct GuardIndex
+{
+	std::optional<RowReader::LeftGuardBound> bound; // the weakest bound of all readers
+	int minRowSize = INT_MAX; // the smallest RowReader::minRowSize() of all readers
+	std::vector<int> bars; // PatternView indices
+
+	explicit GuardIndex(const std::vector<std::unique_ptr<RowReader>>& readers)
+	{
+		for (auto& reader : readers) {
+			if (auto b = reader->leftGuardBound())
+				bound = bound ? RowReader::LeftGuardBound{std::min(bound->factor, b->factor), std::max(bound->offset, b->offset),
+														  std::min(bound->minSize, b->minSize)}
+							  : b;
+			minRowSize = std::min(minRowSize, reader->minRowSize());
+		}
+	}
+
+	// Returns true if none of the readers can find a symbol in row because it has too few bars and spaces. This is the
+	// cheapest possible pre-filter: the number of transitions comes for free with the PatternRow and rows with too little
+	// contrast have already been rejected by the binarizer (see GlobalHistogramBinarizer::getPatternRow).
+	bool canSkip(const PatternRow& row) const { return minRowSize != INT_MAX && Size(row) - 1 < minRowSize; }
+
+	void update(const PatternRow& row)
+	{
+		bars.clear();
+		if (!bound)
+			return;
+		PatternView view(row);
+		// a guard needs to be followed by at least minSize bars and spaces, see FindLeftGuard
+		int end = view.size() - bound->minSize;
+		if (end < 0)
+			return;
+		bars.push_back(0); // the first bar has an 'infinite' quiet zone in front, see FindLeftGuard
+		for (int i = 2; i <= end; i += 2)
+			if ((*bound)(view[i - 1], view[i]))
+				bars.push_back(i);
+	}
+};
+
+// Readers with a DecodingState may initialize it with the first row they see (see DXFilmEdgeReader), so rows are only
+// skipped once all of them have one.
+static bool HaveDecodingStates(const std::vector<std::unique_ptr<RowReader>>& readers,
+							   const std::vector<std::unique_ptr<RowReader::DecodingState>>& states)
+{
+	for (int r = 0; r < Size(readers); ++r)
+		if (readers[r]->usesDecodingState() && !states[r])
+			return false;
+	return true;
+}
+
+// Returns true if the row contains a run of at least minSize bars and spaces that are all narrower than the space in
+// front of it, i.e. something that looks like a symbol with a quiet zone on its left. This is a cheap hint used by the
+// adaptive row scan to decide where to look closer. The shortest symbols (e.g. Code128 with a single character) have
+// about 20 bars and spaces.
+static bool HasSymbolLikeRun(const PatternRow& bars, int minSize = 16)
+{
+	const PatternView row(bars);
+	for (int i = 0; i + minSize <= row.size(); i += 2) {
+		int quietZone = row[i - 1];
+		if (std::all_of(row.begin() + i, row.begin() + i + minSize, [quietZone](int w) { return w < quietZone; }))
+			return true;
+	}
+	return false;
+}
+
+// Runs reader on all possible start positions of the row (only the first one if !tryHarder) and passes each result to
+// onResult. Stops as soon as onResult returns true and reports that to the caller.
+template <typename F>
+static bool DecodeRow(const RowReader& reader, int rowNumber, const PatternRow& bars, const GuardIndex& guards,
+					  std::unique_ptr<RowReader::DecodingState>& state, bool tryHarder, bool returnErrors, F&& onResult)
+{
+	const PatternView row(bars);
+	const auto bound = guards.bound ? reader.leftGuardBound() : std::nullopt;
+	auto guard = guards.bars.begin();
+
+	PatternView next = row;
+	do {
+		if (bound) {
+			// Skip ahead to the next bar that can be the start of the left guard. Since FindLeftGuard() would not find one
+			// in front of it either, the reader returns the same result as if called at the current position.
+			while (guard != guards.bars.end() && (*guard < next.index() || (*guard && !(*bound)(row[*guard - 1], row[*guard]))))
+				++guard;
+			if (guard == guards.bars.end() || *guard + bound->minSize > row.size())
+				break;
+			next = row.subView(*guard);
+		}
+		Barcode result = reader.decodePattern(rowNumber, next, state);
+		if ((result.isValid() || (returnErrors && result.error())) && onResult(std::move(result)))
+			return true;
+		// make sure we make progress and we start the next try on a bar
+		next.shift(2 - (next.index() % 2));
+		next.extend();
+	} while (tryHarder && next.size());
+	return false;
+}
+
+// The parallel lines scanned by DoDecode: the rows (angle 0) or the columns (angle 90) of the image or lines at any other
+// angle in degrees (clockwise, as y points down), which are sampled with BinaryBitmap::getPatternLine(). The lines are
+// one pixel apart. The readers report positions in line coordinates (x along the line, y the index of the line), which
+// are mapped back to image coordinates by toImage().
+class ScanLines
+{
+	const BinaryBitmap& _image;
+	double _angle;
+	bool _subPixel; // see BinaryBitmap::getSubPixelPatternRow(), only for the rows and columns
+	PointF _dir, _normal, _center;
+	int _halfCount = 0, _count = 0, _length = 0;
+
+	// the first and last pixel of the line inside the image, {} if it does not intersect the image
+	std::optional<std::pair<PointI, PointI>> endPoints(int line) const
+	{
+		auto o = _center + (line - _halfCount) * _normal;
+		// clip the line to the pixel centers of the image (Liang-Barsky)
+		double tMin = -1e9, tMax = 1e9;
+		for (auto [pos, dir, max] : {std::tuple{o.x, _dir.x, _image.width() - 1}, std::tuple{o.y, _dir.y, _image.height() - 1}}) {
+			if (std::abs(dir) < 1e-9) {
+				if (pos < 0 || pos > max)
+					return {};
+				continue;
+			}
+			double t0 = (0 - pos) / dir, t1 = (max - pos) / dir;
+			tMin = std::max(tMin, std::min(t0, t1));
+			tMax = std::min(tMax, std::max(t0, t1));
+		}
+		if (tMin > tMax)
+			return {};
+		auto round = [](PointF p) { return PointI(std::lround(p.x), std::lround(p.y)); };
+		return std::pair{round(o + tMin * _dir), round(o + tMax * _dir)};
+	}
+
+public:
+	ScanLines(const BinaryBitmap& image, double angle, bool subPixel = false)
+		: _image(image), _angle(angle), _subPixel(subPixel && (angle == 0 || angle == 90))
+	{
+		if (angle == 0) {
+			_count = image.height(), _length = image.width();
+		} else if (angle == 90) {
+			_count = image.width(), _length = image.height();
+		} else {
+			double a = angle * 3.14159265358979323846 / 180;
+			_dir = {std::cos(a), std::sin(a)};
+			_normal = {-_dir.y, _dir.x};
+			_center = {(image.width() - 1) / 2., (image.height() - 1) / 2.};
+			_halfCount = int(((image.width() - 1) * std::abs(_dir.y) + (image.height() - 1) * std::abs(_dir.x)) / 2);
+			_count = 2 * _halfCount + 1;
+			_length = std::max(image.width(), image.height());
+		}
+	}
+
+	double angle() const { return _angle; }
+	int count() const { return _count; }
+	int length() const { return _length; } // maximum length of a line
+	int subPixelBits() const { return _subPixel ? SUBPIXEL_BITS : 0; } // of the widths in the PatternRow of a line
+
+	bool getPatternRow(int line, PatternRow& res) const
+	{
+		if (_subPixel)
+			return _image.getSubPixelPatternRow(line, int(_angle), res);
+		if (_angle == 0 || _angle == 90)
+			return _image.getPatternRow(line, int(_angle), res);
+		auto ends = endPoints(line);
+		return ends && _image.getPatternLine(ends->first, ends->second, res);
+	}
+
+	PointI toImage(PointI p) const
+	{
+		p.x >>= subPixelBits();
+		if (_angle == 0)
+			return p;
+		if (_angle == 90)
+			return {p.y, _length - p.x - 1};
+		auto ends = endPoints(p.y);
+		if (!ends)
+			return p;
+		return PointI(centered(ends->first) + p.x * bresenhamDirection(PointF(ends->second - ends->first)));
+	}
+};
+
+// maps the position of a result found on a line of length pixels (or fixed-point units, see ScanLines::subPixelBits())
+// to image coordinates
+static void TransformPosition(Barcode& result, bool upsideDown, const ScanLines& lines, int length)
+{
+	auto points = result.position();
+	for (auto& p : points) {
+		if (upsideDown)
+			p = {length - p.x - 1, p.y}; // flip horizontally
+		p = lines.toImage(p);
+	}
+	result.setPosition(std::move(points));
+}
+
+// merges the position of result into the one of other, the same symbol found on another line before
+static void MergePosition(Barcode& other, const Barcode& result, bool rotate)
+{
+	auto dTop = maxAbsComponent(other.position().topLeft() - result.position().topLeft());
+	auto dBot = maxAbsComponent(other.position().bottomLeft() - result.position().topLeft());
+	auto points = other.position();
+	if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) > sumAbsComponent(result.position()[0])))) {
+		points[0] = result.position()[0];
+		points[1] = result.position()[1];
+	} else {
+		points[2] = result.position()[2];
+		points[3] = result.position()[3];
+	}
+	other.setPosition(points);
+}
+
+// The results of the readers not using a DecodingState on one row, in the order they are found by the sequential scan.
+struct ScannedRow
+{
+	struct Result
+	{
+		bool upsideDown;
+		int reader;
+		Barcode barcode;
+	};
+
+	bool valid = false;
+	std::vector<Result> results;
+};
+
 /**
 * We're going to examine rows from the middle outward, searching alternately above and below the
 * middle, and farther out each time. rowStep is the number of rows between each successive
@@ -79,24 +343,32 @@ Reader::~Reader() = default;
 * rowStep is bigger as the image is taller, but is always at least 1. We've somewhat arbitrarily
 * decided that moving up and down by about 1/16 of the image is pretty good; we try more of the
 * image if "trying harder".
+*
+* With adaptive, the scan starts with the sparse grid of rows 1/32 of the image apart, covering the whole image. Every
+* row with a hint of a symbol (see HasSymbolLikeRun()) or a result gets two more rows half way to its neighbors, which
+* are refined the same way, until the rows are next to each other or the hints die out. Additionally the usual check rows
+* are scanned to satisfy minLineCount.
+*
+* With maxThreads != 1, the rows are scanned in chunks: the readers that don't use a DecodingState are run on the rows of
+* a chunk in parallel, then the results are merged in scan order on the calling thread, which also runs the remaining
+* (stacked DataBar) readers. This way the result is the same as with the sequential scan.
 */
-static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image, bool tryHarder,
-						 bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
+static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const ScanLines& lines, bool tryHarder,
+						 bool isPure, int maxSymbols, int minLineCount, bool returnErrors, int maxThreads, bool adaptive)
 {
 	Barcodes res;
 
 	std::vector<std::unique_ptr<RowReader::DecodingState>> decodingState(readers.size());
 
-	int width = image.width();
-	int height = image.height();
+	const int height = lines.count();
+	const bool rotate = lines.angle() >= 90;
 
-	if (rotate)
-		std::swap(width, height);
+	adaptive = adaptive && !isPure;
 
 	int middle = height / 2;
 	// TODO: find a better heuristic/parameterization if maxSymbols != 1
-	int rowStep = std::max(1, height / ((tryHarder && !isPure) ? (maxSymbols == 1 ? 256 : 512) : 32));
-	int maxLines = tryHarder ?
+	int rowStep = std::max(1, height / ((tryHarder && !isPure && !adaptive) ? (maxSymbols == 1 ? 256 : 512) : 32));
+	int maxLines = tryHarder || adaptive ?
 		height :	// Look at the whole image, not just the center
 		15;			// 15 rows spaced 1/32 apart is roughly the middle half of the image
 
@@ -104,135 +376,215 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 		minLineCount = 1;
 	else
 		minLineCount = std::min(minLineCount, height);
-	std::vector<int> checkRows;
-
-	PatternRow bars;
-	bars.reserve(128); // e.g. EAN-13 has 59 bars/spaces
-
-#ifdef PRINT_DEBUG
-	BitMatrix dbg(width, height);
-#endif
 
+	// Scanning from the middle out. Determine which rows we're looking at:
+	std::vector<int> rows;
 	for (int i = 0; i < maxLines; i++) {
-
-		// Scanning from the middle out. Determine which row we're looking at next:
 		int rowStepsAboveOrBelow = (i + 1) / 2;
 		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
 		int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
-		bool isCheckRow = false;
 		if (rowNumber < 0 || rowNumber >= height) {
 			// Oops, if we run off the top or bottom, stop
 			break;
 		}
+		rows.push_back(rowNumber);
+	}
 
-		// See if we have additional check rows (see below) to process
-		if (checkRows.size()) {
-			--i;
-			rowNumber = checkRows.back();
-			checkRows.pop_back();
-			isCheckRow = true;
-			if (rowNumber < 0 || rowNumber >= height)
-				continue;
+	std::vector<int> checkRows;
+
+	// the distance to the neighbor rows and whether a row has been scanned already, only used with adaptive
+	std::vector<int> rowSteps(adaptive ? rows.size() : 0, rowStep);
+	std::vector<bool> isScanned(adaptive ? height : 0);
+	for (int rowNumber : adaptive ? rows : std::vector<int>{})
+		isScanned[rowNumber] = true;
+	bool isHotspot = false; // set by decodeRow
+
+	PatternRow bars;
+	bars.reserve(128); // e.g. EAN-13 has 59 bars/spaces
+	GuardIndex guards(readers);
+
+#ifdef PRINT_DEBUG
+	BitMatrix dbg(lines.length(), height);
+	int scannedRowCount = 0, skippedRowCount = 0;
+#endif
+
+	// returns true if we found maxSymbols
+	auto mergeResult = [&](Barcode&& result, int rowNumber, bool isCheckRow) {
+		// check if we know this code already
+		for (auto& other : res) {
+			if (result == other) {
+				MergePosition(other, result, rotate);
+				IncrementLineCount(other);
+				// clear the result, so we don't insert it again below
+				result = Barcode();
+				break;
+			}
+		}
+
+		if (result.format() != BarcodeFormat::None) {
+			res.push_back(std::move(result));
+
+			// if we found a valid code we have not seen before but a minLineCount > 1,
+			// add additional check rows above and below the current one
+			if (!isCheckRow && minLineCount > 1 && rowStep > 1) {
+				checkRows = {rowNumber - 1, rowNumber + 1};
+				if (rowStep > 2)
+					checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
+			}
 		}
 
-		if (!image.getPatternRow(rowNumber, rotate ? 90 : 0, bars))
-			continue;
+		return maxSymbols
+			   && Reduce(res, 0, [&](int s, const Barcode& r) { return s + (r.lineCount() >= minLineCount); }) == maxSymbols;
+	};
+
+	bool anyUsesDecodingState = std::any_of(readers.begin(), readers.end(), [](auto& r) { return r->usesDecodingState(); });
+	bool anyNeedsReversedRow = !std::all_of(readers.begin(), readers.end(), [](auto& r) { return r->decodesBothDirections(); });
+
+	// returns true if we found maxSymbols. If scanned != nullptr, it contains the results of the readers not using a
+	// DecodingState for this row, so only the others have to be run.
+	auto decodeRow = [&](int i, int rowNumber, bool isCheckRow, ScannedRow* scanned) {
+		isHotspot = false;
+		bool needBars = !scanned || anyUsesDecodingState;
+		if (scanned && !scanned->valid)
+			return false;
+		if (needBars && !lines.getPatternRow(rowNumber, bars))
+			return false;
+		if (adaptive)
+			isHotspot = HasSymbolLikeRun(bars);
+		bool skip = needBars && guards.canSkip(bars) && HaveDecodingStates(readers, decodingState);
+#ifdef PRINT_DEBUG
+		++scannedRowCount;
+		skippedRowCount += skip;
+#endif
+		if (skip)
+			return false;
 
 #ifdef PRINT_DEBUG
 		bool val = false;
 		int x = 0;
-		for (auto b : bars) {
+		for (auto b : needBars ? bars : PatternRow{}) {
 			for(int j = 0; j < b; ++j)
-				dbg.set(x++, rowNumber, val);
+				dbg.set(x++ >> lines.subPixelBits(), rowNumber, val);
 			val = !val;
 		}
 #endif
 
 		// While we have the image data in a PatternRow, it's fairly cheap to reverse it in place to
-		// handle decoding upside down barcodes.
-		// TODO: the DataBarExpanded (stacked) decoder depends on seeing each line from both directions. This
-		// 'surprising' and inconsistent. It also requires the decoderState to be shared between normal and reversed
-		// scans, which makes no sense in general because it would mix partial detection data from two codes of the same
-		// type next to each other. See also https://github.com/zxing-cpp/zxing-cpp/issues/87
+		// handle decoding upside down barcodes. Readers that look at both directions themselves (the stacked DataBar
+		// ones, which need to see the pairs of all rows in their decodingState) are only run on the original row.
+		// TODO: the other readers still scan every row twice as soon as one of them is enabled. Code128, Code39,
+		// Code93, ITF, Codabar and UPC/EAN could tell the direction from their stop pattern and decode backwards from
+		// a single guard match instead (see RowReader::decodesBothDirections()).
 		for (bool upsideDown : {false, true}) {
+			if (upsideDown && !anyNeedsReversedRow)
+				break;
 			// trying again?
-			if (upsideDown) {
+			if (upsideDown && needBars) {
 				// reverse the row and continue
 				std::reverse(bars.begin(), bars.end());
 			}
+			if (needBars)
+				guards.update(bars);
 			// Look for a barcode
-			for (size_t r = 0; r < readers.size(); ++r) {
+			for (int r = 0; r < Size(readers); ++r) {
+				if (upsideDown && readers[r]->decodesBothDirections())
+					continue;
+
 				// If this is a pure symbol, then checking a single non-empty line is sufficient for all but the stacked
 				// DataBar codes. They are the only ones using the decodingState, which we can use as a flag here.
 				if (isPure && i && !decodingState[r])
 					continue;
 
-				PatternView next(bars);
-				do {
-					Barcode result = readers[r]->decodePattern(rowNumber, next, decodingState[r]);
-					if (result.isValid() || (returnErrors && result.error())) {
+				if (scanned && !readers[r]->usesDecodingState()) {
+					for (auto& sr : scanned->results)
+						if (sr.upsideDown == upsideDown && sr.reader == r && mergeResult(std::move(sr.barcode), rowNumber, isCheckRow))
+							return true;
+					continue;
+				}
+
+				if (DecodeRow(*readers[r], rowNumber, bars, guards, decodingState[r], tryHarder, returnErrors, [&](Barcode&& result) {
+						isHotspot = true;
 						IncrementLineCount(result);
-						if (upsideDown) {
-							// update position (flip horizontally).
-							auto points = result.position();
-							for (auto& p : points) {
-								p = {width - p.x - 1, p.y};
-							}
-							result.setPosition(std::move(points));
-						}
-						if (rotate) {
-							auto points = result.position();
-							for (auto& p : points) {
-								p = {p.y, width - p.x - 1};
-							}
-							result.setPosition(std::move(points));
-						}
-
-						// check if we know this code already
-						for (auto& other : res) {
-							if (result == other) {
-								// merge the position information
-								auto dTop = maxAbsComponent(other.position().topLeft() - result.position().topLeft());
-								auto dBot = maxAbsComponent(other.position().bottomLeft() - result.position().topLeft());
-								auto points = other.position();
-								if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) >
-																			  sumAbsComponent(result.position()[0])))) {
-									points[0] = result.position()[0];
-									points[1] = result.position()[1];
-								} else {
-									points[2] = result.position()[2];
-									points[3] = result.position()[3];
-								}
-								other.setPosition(points);
-								IncrementLineCount(other);
-								// clear the result, so we don't insert it again below
-								result = Barcode();
-								break;
-							}
-						}
-
-						if (result.format() != BarcodeFormat::None) {
-							res.push_back(std::move(result));
-
-							// if we found a valid code we have not seen before but a minLineCount > 1,
-							// add additional check rows above and below the current one
-							if (!isCheckRow && minLineCount > 1 && rowStep > 1) {
-								checkRows = {rowNumber - 1, rowNumber + 1};
-								if (rowStep > 2)
-									checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
-							}
-						}
-
-						if (maxSymbols && Reduce(res, 0, [&](int s, const Barcode& r) {
-											  return s + (r.lineCount() >= minLineCount);
-										  }) == maxSymbols) {
-							goto out;
-						}
+						TransformPosition(result, upsideDown, lines, Reduce(bars, 0));
+						return mergeResult(std::move(result), rowNumber, isCheckRow);
+					}))
+					return true;
+			}
+		}
+		return false;
+	};
+
+	// runs all readers that don't use a DecodingState on the given row
+	auto scanRow = [&](int rowNumber, PatternRow& bars, GuardIndex& guards, ScannedRow& scanned) {
+		scanned.results.clear();
+		scanned.valid = lines.getPatternRow(rowNumber, bars);
+		if (!scanned.valid || guards.canSkip(bars))
+			return;
+		std::unique_ptr<RowReader::DecodingState> noState;
+		for (bool upsideDown : {false, true}) {
+			if (upsideDown)
+				std::reverse(bars.begin(), bars.end());
+			guards.update(bars);
+			for (int r = 0; r < Size(readers); ++r)
+				if (!readers[r]->usesDecodingState() && !(upsideDown && readers[r]->decodesBothDirections()))
+					DecodeRow(*readers[r], rowNumber, bars, guards, noState, tryHarder, returnErrors, [&](Barcode&& result) {
+						IncrementLineCount(result);
+						TransformPosition(result, upsideDown, lines, Reduce(bars, 0));
+						scanned.results.push_back({upsideDown, r, std::move(result)});
+						return false;
+					});
+		}
+	};
+
+	// the pure case only looks at a few rows and depends on the decodingState, see above
+	if (isPure || !tryHarder || adaptive || std::all_of(readers.begin(), readers.end(), [](auto& r) { return r->usesDecodingState(); }))
+		maxThreads = 1;
+	maxThreads = std::min(maxThreads, Size(rows) / 16);
+
+	// a single chunk containing all rows if maxThreads == 1 (there are never more than height rows, also with adaptive)
+	const int chunkSize = maxThreads > 1 ? 16 * maxThreads : height;
+	std::vector<ScannedRow> scannedRows(maxThreads > 1 ? chunkSize : 0);
+	std::vector<PatternRow> threadBars(maxThreads);
+	std::vector<GuardIndex> threadGuards(maxThreads, guards);
+
+	for (int chunk = 0; chunk < Size(rows); chunk += chunkSize) {
+		int chunkEnd = std::min(chunk + chunkSize, Size(rows));
+
+		if (maxThreads > 1) {
+			// interleave the rows so every thread gets a similar share of the (middle) rows most likely containing symbols
+			auto scanRows = [&](int t) {
+				for (int i = chunk + t; i < chunkEnd; i += maxThreads)
+					scanRow(rows[i], threadBars[t], threadGuards[t], scannedRows[i - chunk]);
+			};
+			RunOnThreads(maxThreads, scanRows);
+		}
+
+		// with adaptive, rows are added while we go
+		for (int i = chunk; i < (adaptive ? Size(rows) : chunkEnd); ++i) {
+			if (decodeRow(i, rows[i], false, maxThreads > 1 ? &scannedRows[i - chunk] : nullptr))
+				goto out;
+
+			if (adaptive && isHotspot && rowSteps[i] > 1) {
+				int step = rowSteps[i] / 2;
+				for (int rowNumber : {rows[i] - step, rows[i] + step})
+					if (rowNumber >= 0 && rowNumber < height && !isScanned[rowNumber]) {
+						isScanned[rowNumber] = true;
+						rows.push_back(rowNumber);
+						rowSteps.push_back(step);
 					}
-					// make sure we make progress and we start the next try on a bar
-					next.shift(2 - (next.index() % 2));
-					next.extend();
-				} while (tryHarder && next.size());
+			}
+
+			// See if we have additional check rows to process. Like in the original sequential loop, they are not processed
+			// if we ran off the top or bottom.
+			while ((i + 1 < Size(rows) || adaptive) && checkRows.size()) {
+				int rowNumber = checkRows.back();
+				checkRows.pop_back();
+				if (rowNumber < 0 || rowNumber >= height || (adaptive && isScanned[rowNumber]))
+					continue;
+				if (adaptive)
+					isScanned[rowNumber] = true;
+				if (decodeRow(i, rowNumber, true, nullptr))
+					goto out;
 			}
 		}
 	}
@@ -260,33 +612,188 @@ out:
 #endif
 
 #ifdef PRINT_DEBUG
-	SaveAsPBM(dbg, rotate ? "od-log-r.pnm" : "od-log.pnm");
+	printf("scanned %d lines, skipped %d with too few bars and spaces\n", scannedRowCount, skippedRowCount);
+	SaveAsPBM(dbg, lines.angle() == 0 ? "od-log.pnm" : "od-log-" + std::to_string(int(lines.angle())) + ".pnm");
+#endif
+
+	return res;
+}
+
+static bool AdaptiveRowScan([[maybe_unused]] const ReaderOptions& opts)
+{
+#ifdef ZXING_EXPERIMENTAL_API
+	return opts.adaptiveRowScan();
+#else
+	return false;
 #endif
+}
 
+static bool SubPixelRows([[maybe_unused]] const ReaderOptions& opts)
+{
+#ifdef ZXING_EXPERIMENTAL_API
+	return opts.subPixelRows();
+#else
+	return false;
+#endif
+}
+
+// the angles of the additional scan lines, see ReaderOptions::scanLineDirections()
+static std::vector<double> ScanLineAngles([[maybe_unused]] const ReaderOptions& opts)
+{
+	std::vector<double> res;
+#ifdef ZXING_EXPERIMENTAL_API
+	for (int i = 1, n = opts.scanLineDirections(); i < n; ++i)
+		if (2 * i != n) // the columns are scanned with tryRotate
+			res.push_back(180. * i / n);
+#endif
 	return res;
 }
 
 Barcode Reader::decode(const BinaryBitmap& image) const
 {
-	auto result =
-		DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors());
-	
+	auto decode = [&](double angle) {
+		return DoDecode(_readers, ScanLines(image, angle, SubPixelRows(_opts)), _opts.tryHarder(), _opts.isPure(), 1,
+						_opts.minLineCount(), _opts.returnErrors(), MaxThreads(_opts), AdaptiveRowScan(_opts));
+	};
+
+	auto result = decode(0);
+
 	if (result.empty() && _opts.tryRotate())
-		result = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), 1, _opts.minLineCount(), _opts.returnErrors());
+		result = decode(90);
+
+	for (double angle : ScanLineAngles(_opts))
+		if (result.empty())
+			result = decode(angle);
 
 	return FirstOrDefault(std::move(result));
 }
 
 Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
-	auto resH = DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), maxSymbols, _opts.minLineCount(),
-						 _opts.returnErrors());
+	auto decode = [&](double angle, int maxSymbols) {
+		return DoDecode(_readers, ScanLines(image, angle, SubPixelRows(_opts)), _opts.tryHarder(), _opts.isPure(), maxSymbols,
+						_opts.minLineCount(), _opts.returnErrors(), MaxThreads(_opts), AdaptiveRowScan(_opts));
+	};
+
+	auto resH = decode(0, maxSymbols);
 	if ((!maxSymbols || Size(resH) < maxSymbols) && _opts.tryRotate()) {
-		auto resV = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), maxSymbols - Size(resH),
-							 _opts.minLineCount(), _opts.returnErrors());
+		auto resV = decode(90, maxSymbols - Size(resH));
 		resH.insert(resH.end(), resV.begin(), resV.end());
 	}
+
+	for (double angle : ScanLineAngles(_opts)) {
+		if (maxSymbols && Size(resH) >= maxSymbols)
+			break;
+		for (auto& res : decode(angle, maxSymbols - Size(resH))) {
+			// the lines of neighboring angles can find the same symbol
+			if (std::none_of(resH.begin(), resH.end(), [&](const Barcode& other) {
+					return res.format() == other.format() && res.bytes() == other.bytes() &&
+						   HaveIntersectingBoundingBoxes(res.position(), other.position());
+				}))
+				resH.push_back(std::move(res));
+		}
+	}
+
 	return resH;
 }
 
+struct RowStreamReader::Data
+{
+	struct Symbol
+	{
+		Barcode barcode;
+		int lastRow;
+		bool isReported;
+	};
+
+	const ReaderOptions& opts;
+	Reader reader;
+	GuardIndex guards;
+	std::vector<std::unique_ptr<RowReader::DecodingState>> decodingState;
+	std::vector<Symbol> symbols; // seen on the last maxHistory rows
+	int maxHistory;
+	bool anyNeedsReversedRow;
+
+	Data(const ReaderOptions& opts, int maxHistory)
+		: opts(opts),
+		  reader(opts),
+		  guards(reader._readers),
+		  decodingState(reader._readers.size()),
+		  maxHistory(std::max(1, maxHistory)),
+		  anyNeedsReversedRow(!std::all_of(reader._readers.begin(), reader._readers.end(),
+										   [](auto& r) { return r->decodesBothDirections(); }))
+	{}
+};
+
+RowStreamReader::RowStreamReader(const ReaderOptions& opts, int maxHistory) : d(std::make_unique<Data>(opts, maxHistory)) {}
+
+RowStreamReader::~RowStreamReader() = default;
+
+void RowStreamReader::reset()
+{
+	d->symbols.clear();
+	for (auto& state : d->decodingState)
+		state.reset();
+}
+
+Barcodes RowStreamReader::decodeRow(int rowNumber, PatternRow& bars)
+{
+	const auto& readers = d->reader._readers;
+	const int minLineCount = std::max(1, int(d->opts.minLineCount()));
+	const int width = Reduce(bars, 0);
+	Barcodes res;
+
+	// see DoDecode(), which does the same for the rows of an image in the order they are scanned
+	for (bool upsideDown : {false, true}) {
+		if ((upsideDown && !d->anyNeedsReversedRow) || (d->guards.canSkip(bars) && HaveDecodingStates(readers, d->decodingState)))
+			break;
+		if (upsideDown)
+			std::reverse(bars.begin(), bars.end());
+		d->guards.update(bars);
+		for (int r = 0; r < Size(readers); ++r) {
+			if (upsideDown && readers[r]->decodesBothDirections())
+				continue;
+			DecodeRow(*readers[r], rowNumber, bars, d->guards, d->decodingState[r], d->opts.tryHarder(), d->opts.returnErrors(),
+					  [&](Barcode&& result) {
+						  IncrementLineCount(result);
+						  if (upsideDown) {
+							  auto points = result.position();
+							  for (auto& p : points)
+								  p = {width - p.x - 1, p.y};
+							  result.setPosition(std::move(points));
+						  }
+
+						  auto known = FindIf(d->symbols, [&](const Data::Symbol& s) { return s.barcode == result; });
+						  if (known != d->symbols.end()) {
+							  MergePosition(known->barcode, result, false);
+							  IncrementLineCount(known->barcode);
+							  known->lastRow = rowNumber;
+						  } else {
+							  d->symbols.push_back({std::move(result), rowNumber, false});
+							  known = std::prev(d->symbols.end());
+						  }
+						  if (!known->isReported && known->barcode.lineCount() >= minLineCount) {
+							  known->isReported = true;
+							  res.push_back(known->barcode);
+						  }
+						  return false;
+					  });
+		}
+	}
+
+	// forget everything that has not been seen on the last maxHistory rows
+	int firstRow = rowNumber - d->maxHistory + 1;
+#ifdef __cpp_lib_erase_if
+	std::erase_if(d->symbols, [&](auto&& s) { return s.lastRow < firstRow; });
+#else
+	d->symbols.erase(std::remove_if(d->symbols.begin(), d->symbols.end(), [&](auto&& s) { return s.lastRow < firstRow; }),
+					 d->symbols.end());
+#endif
+	for (auto& state : d->decodingState)
+		if (state)
+			state->forgetRowsBefore(firstRow);
+
+	return res;
+}
+
 } // namespace ZXing::OneD
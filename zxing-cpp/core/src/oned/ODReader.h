@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Pattern.h"
 #include "Reader.h"
 
 #include <memory>
@@ -30,6 +31,29 @@ public:
 
 private:
 	std::vector<std::unique_ptr<RowReader>> _readers;
+
+	friend class RowStreamReader;
+};
+
+/**
+ * Decodes a stream of rows one at a time, in the order they arrive (e.g. from a line-scan camera). Each symbol is
+ * returned once, as soon as it has been seen on minLineCount rows. Symbols and stacked DataBar pairs that have not been
+ * seen for maxHistory rows are forgotten, so the memory use does not grow with the length of the stream.
+ */
+class RowStreamReader
+{
+	struct Data;
+	std::unique_ptr<Data> d;
+
+public:
+	RowStreamReader(const ReaderOptions& opts, int maxHistory);
+	~RowStreamReader();
+
+	// Decodes the pattern of the row with the given number, which has to be larger than the one of the previous call.
+	// bars is used as scratch memory. The positions of the returned symbols are in stream coordinates.
+	Barcodes decodeRow(int rowNumber, PatternRow& bars);
+
+	void reset();
 };
 
 } // OneD
@@ -19,6 +19,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <optional>
 
 /*
 Code39 : 1:2/3, 5+4+1 (0x3|2x1 wide) -> 12-15 mods, v1-? | ToNarrowWide(OMG 1) == *
@@ -60,12 +61,46 @@ public:
 	struct DecodingState
 	{
 		virtual ~DecodingState() = default;
+
+		// Forget everything first seen on a row before rowNumber. Used to bound the memory when decoding an endless
+		// stream of rows, see RowStreamReader.
+		virtual void forgetRowsBefore(int /*rowNumber*/) {}
 	};
 
 	virtual ~RowReader() {}
 
 	virtual Barcode decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const = 0;
 
+	// Readers that collect information across rows in their DecodingState (e.g. stacked symbols) need to see the rows
+	// in scan order. All others only look at the current row and can be run on different rows in parallel.
+	virtual bool usesDecodingState() const { return false; }
+
+	// Readers that look at the row in both directions themselves (see PatternView::reversedRow()) are not run again on the
+	// reversed row to find upside down symbols. Positions they return are in the coordinates of the original row. So far
+	// these are only the stacked DataBar readers, which need the pairs of both directions in their DecodingState.
+	virtual bool decodesBothDirections() const { return false; }
+
+	// Readers whose decodePattern() starts by looking for a left guard with FindLeftGuard() can provide a necessary
+	// condition for a bar to be the start of that guard: the space in front has to be >= factor * bar - offset and there
+	// have to be at least minSize bars and spaces starting at the guard (the minSize passed to FindLeftGuard()). The row
+	// scan then only calls decodePattern() at bars that fulfill it, see DoDecode().
+	struct LeftGuardBound
+	{
+		float factor, offset;
+		int minSize = 0;
+		bool operator()(int space, int bar) const { return space >= factor * bar - offset; }
+	};
+
+	virtual std::optional<LeftGuardBound> leftGuardBound() const { return {}; }
+
+	// The minimal number of bars and spaces a row needs for decodePattern() to find anything in it, 0 if there is no such
+	// bound. Rows with fewer are not scanned if all readers provide a bound, see DoDecode().
+	virtual int minRowSize() const
+	{
+		auto bound = leftGuardBound();
+		return bound ? bound->minSize : 0;
+	}
+
 	/**
 	 * Determines how closely a set of observed counts of runs of black/white values matches a given
 	 * target pattern. This is reported as the ratio of the total variance from the expected pattern
@@ -207,6 +242,13 @@ public:
 		return i == -1 ? 0 : alphabet[i];
 	}
 
+	template<int N, typename ALPHABET>
+	static char LookupBitPattern(int pattern, const PatternIndex<N>& index, const ALPHABET& alphabet)
+	{
+		int i = index.indexOf(pattern);
+		return i == -1 ? 0 : alphabet[i];
+	}
+
 	template<typename INDEX, typename ALPHABET>
 	static char DecodeNarrowWidePattern(const PatternView& view, const INDEX& table, const ALPHABET& alphabet)
 	{
@@ -25,7 +25,18 @@ extern const std::array<int, 3> START_END_PATTERN;
 /**
  * "Odd", or "L" patterns used to encode UPC/EAN digits.
  */
-extern const std::array<Digit, 10> L_PATTERNS;
+inline constexpr std::array<Digit, 10> L_PATTERNS = {
+	3, 2, 1, 1, // 0
+	2, 2, 2, 1, // 1
+	2, 1, 2, 2, // 2
+	1, 4, 1, 1, // 3
+	1, 1, 3, 2, // 4
+	1, 2, 3, 1, // 5
+	1, 1, 1, 4, // 6
+	1, 3, 1, 2, // 7
+	1, 2, 1, 3, // 8
+	3, 1, 1, 2, // 9
+};
 
 /**
  * Pattern marking the middle of a UPC/EAN pattern, separating the two halves.
@@ -35,7 +46,29 @@ extern const std::array<int, 5> MIDDLE_PATTERN;
 /**
  * As above but also including the "even", or "G" patterns used to encode UPC/EAN digits.
  */
-extern const std::array<Digit, 20> L_AND_G_PATTERNS;
+inline constexpr std::array<Digit, 20> L_AND_G_PATTERNS = {
+	3, 2, 1, 1, // 0
+	2, 2, 2, 1, // 1
+	2, 1, 2, 2, // 2
+	1, 4, 1, 1, // 3
+	1, 1, 3, 2, // 4
+	1, 2, 3, 1, // 5
+	1, 1, 1, 4, // 6
+	1, 3, 1, 2, // 7
+	1, 2, 1, 3, // 8
+	3, 1, 1, 2, // 9
+	// reversed
+	1, 1, 2, 3, // 10
+	1, 2, 2, 2, // 11
+	2, 2, 1, 2, // 12
+	1, 1, 4, 1, // 13
+	2, 3, 1, 1, // 14
+	1, 3, 2, 1, // 15
+	4, 1, 1, 1, // 16
+	2, 1, 3, 1, // 17
+	3, 1, 2, 1, // 18
+	2, 1, 1, 3, // 19
+};
 
 /**
  * UPCE end guard pattern (== MIDDLE_PATTERN + single module black bar)
@@ -14,7 +14,12 @@
 #include "QRFormatInformation.h"
 #include "QRVersion.h"
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace ZXing::QRCode {
 
@@ -98,45 +103,76 @@ FormatInformation ReadFormatInformation(const BitMatrix& bitMatrix)
 	return FormatInformation::DecodeQR(formatInfoBits1, formatInfoBits2);
 }
 
-static ByteArray ReadQRCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
+// A data module of a symbol, with the values of all data masks (bit i is mask i) at its position.
+struct DataModule
+{
+	uint8_t x, y, masks;
+};
+using DataModules = std::vector<DataModule>;
+
+// Collects all modules not covered by the function pattern in the order they are read, see ISO 18004:2015 7.7.3.
+static DataModules BuildDataModules(const Version& version)
 {
 	BitMatrix functionPattern = version.buildFunctionPattern();
 
-	ByteArray result;
-	result.reserve(version.totalCodewords());
-	uint8_t currentByte = 0;
+	DataModules result;
 	bool readingUp = true;
-	int bitsRead = 0;
-	int dimension = bitMatrix.height();
+	const int width = functionPattern.width();
+	const int height = functionPattern.height();
 	// Read columns in pairs, from right to left
-	for (int x = dimension - 1; x > 0; x -= 2) {
+	for (int x = width - 1 - version.isRMQR(); x > 0; x -= 2) { // rMQR: skip right edge alignment
 		// Skip whole column with vertical timing pattern.
-		if (x == 6)
+		if (version.isModel2() && x == 6)
 			x--;
 		// Read alternatingly from bottom to top then top to bottom
-		for (int row = 0; row < dimension; row++) {
-			int y = readingUp ? dimension - 1 - row : row;
+		for (int row = 0; row < height; row++) {
+			int y = readingUp ? height - 1 - row : row;
 			for (int col = 0; col < 2; col++) {
 				int xx = x - col;
 				// Ignore bits covered by the function pattern
 				if (!functionPattern.get(xx, y)) {
-					// Read a bit
-					AppendBit(currentByte,
-							  GetDataMaskBit(formatInfo.dataMask, xx, y) != getBit(bitMatrix, xx, y, formatInfo.isMirrored));
-					// If we've made a whole byte, save it off
-					if (++bitsRead % 8 == 0)
-						result.push_back(std::exchange(currentByte, 0));
+					uint8_t masks = 0;
+					for (int i = 0; i < (version.isMicro() ? 4 : 8); ++i)
+						masks |= GetDataMaskBit(i, xx, y, version.isMicro()) << i;
+					result.push_back({narrow_cast<uint8_t>(xx), narrow_cast<uint8_t>(y), masks});
 				}
 			}
 		}
 		readingUp = !readingUp; // switch directions
 	}
-	if (Size(result) != version.totalCodewords())
-		return {};
 
 	return result;
 }
 
+// Returns the DataModules of version, which are built once on first use.
+static const DataModules& CachedDataModules(const Version& version)
+{
+	// one entry for each version of Model2, Micro and rMQR symbols
+	constexpr int MODEL2 = 0, MICRO = MODEL2 + 40, RMQR = MICRO + 4, COUNT = RMQR + 32;
+	static std::array<std::once_flag, COUNT> once;
+	static std::array<DataModules, COUNT> cache;
+
+	int i = version.versionNumber() - 1 + (version.isMicro() ? MICRO : version.isRMQR() ? RMQR : MODEL2);
+	std::call_once(once[i], [&] { cache[i] = BuildDataModules(version); });
+	return cache[i];
+}
+
+static bool ReadQRCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo, uint8_t* result)
+{
+	const auto& modules = CachedDataModules(version);
+
+	if (Size(modules) / 8 != version.totalCodewords())
+		return false;
+
+	std::fill_n(result, version.totalCodewords(), 0);
+	for (int i = 0; i < version.totalCodewords() * 8; ++i) {
+		auto& m = modules[i];
+		AppendBit(result[i / 8], ((m.masks >> formatInfo.dataMask) & 1) != getBit(bitMatrix, m.x, m.y, formatInfo.isMirrored));
+	}
+
+	return true;
+}
+
 static ByteArray ReadQRCodewordsModel1(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
 {
 	ByteArray result;
@@ -198,7 +234,10 @@ static ByteArray ReadQRCodewordsModel1(const BitMatrix& bitMatrix, const Version
 
 static ByteArray ReadMQRCodewords(const BitMatrix& bitMatrix, const QRCode::Version& version, const FormatInformation& formatInfo)
 {
-	BitMatrix functionPattern = version.buildFunctionPattern();
+	if (formatInfo.dataMask >= 4)
+		throw std::invalid_argument("QRCode maskIndex out of range");
+
+	const auto& modules = CachedDataModules(version);
 
 	// D3 in a Version M1 symbol, D11 in a Version M3-L symbol and D9
 	// in a Version M3-M symbol is a 2x2 square 4-module block.
@@ -210,68 +249,15 @@ static ByteArray ReadMQRCodewords(const BitMatrix& bitMatrix, const QRCode::Vers
 	ByteArray result;
 	result.reserve(version.totalCodewords());
 	uint8_t currentByte = 0;
-	bool readingUp = true;
-	int bitsRead = 0;
-	int dimension = bitMatrix.height();
-	// Read columns in pairs, from right to left
-	for (int x = dimension - 1; x > 0; x -= 2) {
-		// Read alternatingly from bottom to top then top to bottom
-		for (int row = 0; row < dimension; row++) {
-			int y = readingUp ? dimension - 1 - row : row;
-			for (int col = 0; col < 2; col++) {
-				int xx = x - col;
-				// Ignore bits covered by the function pattern
-				if (!functionPattern.get(xx, y)) {
-					// Read a bit
-					AppendBit(currentByte,
-							  GetDataMaskBit(formatInfo.dataMask, xx, y, true) != getBit(bitMatrix, xx, y, formatInfo.isMirrored));
-					++bitsRead;
-					// If we've made a whole byte, save it off; save early if 2x2 data block.
-					if (bitsRead == 8 || (bitsRead == 4 && hasD4mBlock && Size(result) == d4mBlockIndex - 1)) {
-						result.push_back(std::exchange(currentByte, 0));
-						bitsRead = 0;
-					}
-				}
-			}
-		}
-		readingUp = !readingUp; // switch directions
-	}
-	if (Size(result) != version.totalCodewords())
-		return {};
-
-	return result;
-}
-
-static ByteArray ReadRMQRCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
-{
-	BitMatrix functionPattern = version.buildFunctionPattern();
-
-	ByteArray result;
-	result.reserve(version.totalCodewords());
-	uint8_t currentByte = 0;
-	bool readingUp = true;
 	int bitsRead = 0;
-	const int width = bitMatrix.width();
-	const int height = bitMatrix.height();
-	// Read columns in pairs, from right to left
-	for (int x = width - 1 - 1; x > 0; x -= 2) { // Skip right edge alignment
-		// Read alternatingly from bottom to top then top to bottom
-		for (int row = 0; row < height; row++) {
-			int y = readingUp ? height - 1 - row : row;
-			for (int col = 0; col < 2; col++) {
-				int xx = x - col;
-				// Ignore bits covered by the function pattern
-				if (!functionPattern.get(xx, y)) {
-					// Read a bit
-					AppendBit(currentByte,
-							  GetDataMaskBit(formatInfo.dataMask, xx, y) != getBit(bitMatrix, xx, y, formatInfo.isMirrored));
-					// If we've made a whole byte, save it off
-					if (++bitsRead % 8 == 0)
-						result.push_back(std::exchange(currentByte, 0));
-				}
-			}
+	for (auto& m : modules) {
+		AppendBit(currentByte, ((m.masks >> formatInfo.dataMask) & 1) != getBit(bitMatrix, m.x, m.y, formatInfo.isMirrored));
+		++bitsRead;
+		// If we've made a whole byte, save it off; save early if 2x2 data block.
+		if (bitsRead == 8 || (bitsRead == 4 && hasD4mBlock && Size(result) == d4mBlockIndex - 1)) {
+			result.push_back(std::exchange(currentByte, 0));
+			bitsRead = 0;
 		}
-		readingUp = !readingUp; // switch directions
 	}
 	if (Size(result) != version.totalCodewords())
 		return {};
@@ -283,12 +269,28 @@ ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, cons
 {
 	switch (version.type()) {
 	case Type::Micro: return ReadMQRCodewords(bitMatrix, version, formatInfo);
-	case Type::rMQR: return ReadRMQRCodewords(bitMatrix, version, formatInfo);
 	case Type::Model1: return ReadQRCodewordsModel1(bitMatrix, version, formatInfo);
-	case Type::Model2: return ReadQRCodewords(bitMatrix, version, formatInfo);
+	case Type::Model2:
+	case Type::rMQR: {
+		ByteArray result(version.totalCodewords());
+		return ReadQRCodewords(bitMatrix, version, formatInfo, result.data()) ? result : ByteArray();
+	}
 	}
 
 	return {};
 }
 
+bool ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo, uint8_t* codewords)
+{
+	if (version.type() == Type::Model2 || version.type() == Type::rMQR)
+		return ReadQRCodewords(bitMatrix, version, formatInfo, codewords);
+
+	ByteArray result = ReadCodewords(bitMatrix, version, formatInfo);
+	if (Size(result) != version.totalCodewords())
+		return false;
+
+	std::copy(result.begin(), result.end(), codewords);
+	return true;
+}
+
 } // namespace ZXing::QRCode
@@ -8,6 +8,8 @@
 
 #include "QRErrorCorrectionLevel.h"
 
+#include <cstdint>
+
 namespace ZXing {
 
 class BitMatrix;
@@ -37,5 +39,12 @@ FormatInformation ReadFormatInformation(const BitMatrix& bitMatrix);
  */
 ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo);
 
+/**
+ * @brief Reads the codewords from the BitMatrix into caller provided storage.
+ * @param codewords room for version.totalCodewords() bytes
+ * @return false if the exact number of bytes expected is not read
+ */
+bool ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo, uint8_t* codewords);
+
 } // QRCode
 } // ZXing
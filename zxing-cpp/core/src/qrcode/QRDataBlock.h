@@ -6,9 +6,7 @@
 
 #pragma once
 
-#include "ByteArray.h"
-
-#include <vector>
+#include <cstdint>
 
 namespace ZXing::QRCode {
 
@@ -16,37 +14,40 @@ class Version;
 enum class ErrorCorrectionLevel;
 
 /**
-* <p>Encapsulates a block of data within a QR Code. QR Codes may split their data into
-* multiple blocks, each of which is a unit of data and error-correction codewords. Each
-* is represented by an instance of this class.</p>
+* <p>QR Codes may split their data into multiple blocks, each of which is a unit of data and error-correction codewords.
+* When QR Codes use multiple data blocks, they are actually interleaved. That is, the first byte of data block 1 to n is
+* written, then the second bytes, and so on. This class separates the data into the original blocks, one block at a time
+* and without copying the whole symbol.</p>
 *
 * @author Sean Owen
 */
-class DataBlock
+class DataBlocks
 {
-public:
-	int numDataCodewords() const { return _numDataCodewords; }
-
-	const ByteArray& codewords() const { return _codewords; }
-
-	ByteArray& codewords() { return _codewords; }
+	const uint8_t* _rawCodewords = nullptr;
+	int _numBlocks = 0;
+	int _firstLongerBlock = 0; // all blocks have the same amount of data, except that the last n (where n may be 0) have 1 more byte
+	int _numShorterDataCodewords = 0;
+	int _numECCodewords = 0; // per block
 
+public:
 	/**
-	* <p>When QR Codes use multiple data blocks, they are actually interleaved.
-	* That is, the first byte of data block 1 to n is written, then the second bytes, and so on. This
-	* method will separate the data into original blocks.</p>
-	*
-	* @param rawCodewords bytes as read directly from the QR Code
+	* @param rawCodewords bytes as read directly from the QR Code, version.totalCodewords() of them
 	* @param version version of the QR Code
 	* @param ecLevel error-correction level of the QR Code
-	* @return DataBlocks containing original bytes, "de-interleaved" from representation in the
-	*         QR Code
 	*/
-	static std::vector<DataBlock> GetDataBlocks(const ByteArray& rawCodewords, const Version& version, ErrorCorrectionLevel ecLevel);
+	DataBlocks(const uint8_t* rawCodewords, const Version& version, ErrorCorrectionLevel ecLevel);
 
-private:
-	int _numDataCodewords = 0;
-	ByteArray _codewords;
+	// the number of blocks, 0 if there are none for the version and ecLevel
+	int size() const { return _numBlocks; }
+
+	int numDataCodewords(int block) const { return _numShorterDataCodewords + (block >= _firstLongerBlock); }
+	int numCodewords(int block) const { return numDataCodewords(block) + _numECCodewords; }
+
+	/**
+	* @brief De-interleave the data and error-correction codewords of a block.
+	* @param codewords room for numCodewords(block) codewords
+	*/
+	void copyTo(int block, int* codewords) const;
 };
 
 } // namespace ZXing::QRCode
@@ -19,39 +19,36 @@
 #include "ReedSolomonDecoder.h"
 #include "StructuredAppend.h"
 #include "ZXAlgorithms.h"
+#include "ZXConfig.h"
 #include "ZXTestSupport.h"
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
 namespace ZXing::QRCode {
 
+// The largest symbol (version 40) has 3706 codewords and no Reed-Solomon block over GF(256) can be longer than 255.
+constexpr int MAX_TOTAL_CODEWORDS = 3706;
+constexpr int MAX_BLOCK_CODEWORDS = 255;
+
 /**
 * <p>Given data and error-correction codewords received, possibly corrupted by errors, attempts to
 * correct the errors in-place using Reed-Solomon error correction.</p>
 *
-* @param codewordBytes data and error correction codewords
+* @param codewords data and error correction codewords
+* @param numCodewords number of codewords in the block
 * @param numDataCodewords number of codewords that are data bytes
+* @param numErrors set to the number of codewords that were fixed
 * @return false if error correction fails
 */
-static bool CorrectErrors(ByteArray& codewordBytes, int numDataCodewords)
+static bool CorrectErrors(int* codewords, int numCodewords, int numDataCodewords, int& numErrors)
 {
-	// First read into an array of ints
-	std::vector<int> codewordsInts(codewordBytes.begin(), codewordBytes.end());
-
-	int numECCodewords = Size(codewordBytes) - numDataCodewords;
-	if (!ReedSolomonDecode(GenericGF::QRCodeField256(), codewordsInts, numECCodewords))
-		return false;
-
-	// Copy back into array of bytes -- only need to worry about the bytes that were data
-	// We don't care about errors in the error-correction codewords
-	std::copy_n(codewordsInts.begin(), numDataCodewords, codewordBytes.begin());
-	return true;
+	return ReedSolomonDecode(GenericGF::QRCodeField256(), codewords, numCodewords, numCodewords - numDataCodewords, &numErrors);
 }
 
-
 /**
 * See specification GBT 18284-2000
 */
@@ -132,36 +129,37 @@ static char ToAlphaNumericChar(int value)
 
 static void DecodeAlphanumericSegment(BitSource& bits, int count, Content& result)
 {
+	result.switchEncoding(CharacterSet::ISO8859_1);
+	result.reserve(count);
+	auto begin = result.bytes.size();
+
 	// Read two characters at a time
-	std::string buffer;
 	while (count > 1) {
 		int nextTwoCharsBits = bits.readBits(11);
-		buffer += ToAlphaNumericChar(nextTwoCharsBits / 45);
-		buffer += ToAlphaNumericChar(nextTwoCharsBits % 45);
+		result += ToAlphaNumericChar(nextTwoCharsBits / 45);
+		result += ToAlphaNumericChar(nextTwoCharsBits % 45);
 		count -= 2;
 	}
 	if (count == 1) {
 		// special case: one character left
-		buffer += ToAlphaNumericChar(bits.readBits(6));
+		result += ToAlphaNumericChar(bits.readBits(6));
 	}
 	// See section 6.4.8.1, 6.4.8.2
 	if (result.symbology.aiFlag != AIFlag::None) {
 		// We need to massage the result a bit if in an FNC1 mode:
-		for (auto i = buffer.begin(); i != buffer.end(); i++) {
+		auto& bytes = result.bytes;
+		for (auto i = bytes.begin() + begin; i != bytes.end(); i++) {
 			if (*i == '%') {
-				if (i + 1 != buffer.end() && *(i + 1) == '%') {
+				if (i + 1 != bytes.end() && *(i + 1) == '%') {
 					// %% is rendered as %
-					i = buffer.erase(i);
+					i = bytes.erase(i);
 				} else {
 					// In alpha mode, % should be converted to FNC1 separator 0x1D
-					*i = static_cast<char>(0x1D);
+					*i = 0x1D;
 				}
 			}
 		}
 	}
-
-	result.switchEncoding(CharacterSet::ISO8859_1);
-	result += buffer;
 }
 
 static void DecodeNumericSegment(BitSource& bits, int count, Content& result)
@@ -228,10 +226,12 @@ bool IsEndOfStream(const BitSource& bits, const Version& version)
 * <p>See ISO 18004:2006, 6.4.3 - 6.4.7</p>
 */
 ZXING_EXPORT_TEST_ONLY
-DecoderResult DecodeBitStream(ByteArray&& bytes, const Version& version, ErrorCorrectionLevel ecLevel)
+DecoderResult DecodeBitStream(const ByteArray& bytes, const Version& version, ErrorCorrectionLevel ecLevel)
 {
 	BitSource bits(bytes);
 	Content result;
+	// numeric segments pack the most characters into a byte (3 digits in 10 bits), reserve enough for all of them at once
+	result.reserve(3 * Size(bytes));
 	Error error;
 	result.symbology = {'Q', version.isModel1() ? '0' : '1', 1};
 	StructuredAppendInfo structuredAppend;
@@ -334,39 +334,45 @@ DecoderResult Decode(const BitMatrix& bits)
 
 	const Version& version = *pversion;
 
-	// Read codewords
-	ByteArray codewords = ReadCodewords(bits, version, formatInfo);
-	if (codewords.empty())
+	// Read codewords, version 40 has the most of them, so there is no need to allocate memory
+	std::array<uint8_t, MAX_TOTAL_CODEWORDS> codewords;
+	if (version.totalCodewords() > Size(codewords) || !ReadCodewords(bits, version, formatInfo, codewords.data()))
 		return FormatError("Failed to read codewords");
 
 	// Separate into data blocks
-	std::vector<DataBlock> dataBlocks = DataBlock::GetDataBlocks(codewords, version, formatInfo.ecLevel);
-	if (dataBlocks.empty())
+	DataBlocks dataBlocks(codewords.data(), version, formatInfo.ecLevel);
+	if (dataBlocks.size() == 0)
 		return FormatError("Failed to get data blocks");
 
-	// Count total number of data bytes
-	const auto op = [](auto totalBytes, const auto& dataBlock){ return totalBytes + dataBlock.numDataCodewords();};
-	const auto totalBytes = Reduce(dataBlocks, int{}, op);
-	ByteArray resultBytes(totalBytes);
-	auto resultIterator = resultBytes.begin();
-
 	// Error-correct and copy data blocks together into a stream of bytes
+	ZX_THREAD_LOCAL ByteArray resultBytes;
+	resultBytes.clear();
 	Error error;
-	for (auto& dataBlock : dataBlocks)
-	{
-		ByteArray& codewordBytes = dataBlock.codewords();
-		int numDataCodewords = dataBlock.numDataCodewords();
-
-		if (!CorrectErrors(codewordBytes, numDataCodewords))
+	int ecCodewords = 0, errorsCorrected = 0;
+	for (int i = 0; i < dataBlocks.size(); ++i) {
+		std::array<int, MAX_BLOCK_CODEWORDS> blockCodewords;
+		int numCodewords = dataBlocks.numCodewords(i);
+		int numDataCodewords = dataBlocks.numDataCodewords(i);
+		if (numCodewords > Size(blockCodewords))
+			return FormatError("Failed to get data blocks");
+
+		dataBlocks.copyTo(i, blockCodewords.data());
+		int numErrors = 0;
+		if (!CorrectErrors(blockCodewords.data(), numCodewords, numDataCodewords, numErrors))
 			error = ChecksumError();
+		ecCodewords += numCodewords - numDataCodewords;
+		errorsCorrected += numErrors;
 
-		resultIterator = std::copy_n(codewordBytes.begin(), numDataCodewords, resultIterator);
+		// We don't care about errors in the error-correction codewords
+		resultBytes.insert(resultBytes.end(), blockCodewords.begin(), blockCodewords.begin() + numDataCodewords);
 	}
 
 	// Decode the contents of that stream of bytes
-	auto ret = DecodeBitStream(std::move(resultBytes), version, formatInfo.ecLevel)
+	auto ret = DecodeBitStream(resultBytes, version, formatInfo.ecLevel)
 		.setDataMask(formatInfo.mask)
-		.setIsMirrored(formatInfo.isMirrored);
+		.setIsMirrored(formatInfo.isMirrored)
+		.setEcCodewords(ecCodewords)
+		.setErrorsCorrected(errorsCorrected);
 	if (error)
 		ret.setError(error);
 	return ret;
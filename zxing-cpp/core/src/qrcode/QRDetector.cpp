@@ -19,17 +19,20 @@
 #include "QRVersion.h"
 #include "Quadrilateral.h"
 #include "RegressionLine.h"
+#include "ZXThreads.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
-#include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #ifdef PRINT_DEBUG
 #include "BitMatrixIO.h"
+
+#include <atomic>
 #else
 #define printf(...){}
 #endif
@@ -49,10 +52,43 @@ PatternView FindPattern(const PatternView& view)
 	});
 }
 
-std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+// A spatial hash of the area covered by finder patterns, to quickly check if a point lies inside one of them.
+class FinderPatternAreas
+{
+	static constexpr int CELL_SIZE = 16; // pixels
+	std::unordered_map<uint32_t, std::vector<int>> _cells; // indices into _patterns
+	FinderPatterns _patterns;
+
+	static uint32_t key(int x, int y) { return (uint32_t(y) << 16) | uint32_t(x); }
+
+public:
+	const FinderPatterns& patterns() const { return _patterns; }
+
+	bool contains(PointF p) const
+	{
+		auto cell = _cells.find(key(int(p.x) / CELL_SIZE, int(p.y) / CELL_SIZE));
+		return cell != _cells.end()
+			   && std::any_of(cell->second.begin(), cell->second.end(),
+							  [&](int i) { return distance(p, _patterns[i]) < _patterns[i].size / 2; });
+	}
+
+	void add(const ConcentricPattern& pattern)
+	{
+		auto r = pattern.size / 2.;
+		for (int y = std::max(0, int(pattern.y - r) / CELL_SIZE); y <= int(pattern.y + r) / CELL_SIZE; ++y)
+			for (int x = std::max(0, int(pattern.x - r) / CELL_SIZE); x <= int(pattern.x + r) / CELL_SIZE; ++x)
+				_cells[key(x, y)].push_back(Size(_patterns));
+		_patterns.push_back(pattern);
+	}
+};
+
+FinderPatterns FindFinderPatterns(const DualPolarityBitMatrix& images, bool tryHarder, int maxThreads)
 {
+	const BitMatrix& image = images(false);
+
 	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
 	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
+	constexpr int STRIPE_ROWS      = 32;          // number of scanned rows per stripe
 
 	// Let's assume that the maximum version QR Code we support takes up 1/4 the height of the
 	// image, and then account for the center being 3 modules in size. This gives the smallest
@@ -63,45 +99,131 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 	if (skip < MIN_SKIP || tryHarder)
 		skip = MIN_SKIP;
 
-	std::vector<ConcentricPattern> res;
-	[[maybe_unused]] int N = 0;
-	PatternRow row;
-
-	for (int y = skip - 1; y < height; y += skip) {
-		GetPatternRow(image, y, row, false);
-		PatternView next = row;
-
-		while (next = FindPattern(next), next.isValid()) {
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
-
-			// make sure p is not 'inside' an already found pattern area
-			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
-				log(p);
-				N++;
-				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p,
-															next.sum() * 3); // 3 for very skewed samples
-				if (pattern) {
-					log(*pattern, 3);
-					log(*pattern + PointF(.2, 0), 3);
-					log(*pattern - PointF(.2, 0), 3);
-					log(*pattern + PointF(0, .2), 3);
-					log(*pattern - PointF(0, .2), 3);
-					assert(image.get(pattern->x, pattern->y));
-					res.push_back(*pattern);
+	// The image is scanned in horizontal stripes of a fixed number of rows, which can be processed in parallel. A pattern
+	// crossing the border between two stripes is found in both and only the one of the upper stripe is kept below. This
+	// is also the one that would have been found by scanning all rows in one go.
+	const int stripeHeight = STRIPE_ROWS * skip;
+	const int nbStripes = (height + stripeHeight - 1) / stripeHeight;
+	std::vector<FinderPatternAreas> stripes(nbStripes);
+
+	auto scanStripe = [&](int stripe, PatternRow& row, PatternRow& invRow) {
+		auto& found = stripes[stripe];
+		for (int y = stripe * stripeHeight + skip - 1; y < std::min(height, (stripe + 1) * stripeHeight); y += skip) {
+			GetPatternRow(image, y, row, false);
+
+			// the 1:1:3:1:1 pattern reads the same with swapped bars and spaces, so inverted finder patterns are found in
+			// the same row with the roles of bars and spaces swapped
+			for (bool inverted : {false, true}) {
+				if (inverted && !images.tryInverted())
+					break;
+
+				PatternView next = row;
+				if (inverted) {
+					// the inverted row starts with a space, which is either dropped (if it is empty) or inserted (with width 0)
+					invRow.assign(row.begin() + (row.front() == 0), row.end());
+					if (row.front() != 0)
+						invRow.insert(invRow.begin(), 0);
+					next = invRow;
 				}
-			}
 
-			next.skipPair();
-			next.skipPair();
-			next.extend();
+				while (next = FindPattern(next), next.isValid()) {
+					PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
+
+					// make sure p is not 'inside' an already found pattern area
+					if (!found.contains(p)) {
+						log(p);
+						auto pattern = LocateConcentricPattern<E2E>(images(inverted), PATTERN, p,
+																	next.sum() * 3); // 3 for very skewed samples
+						if (pattern) {
+							log(*pattern, 3);
+							log(*pattern + PointF(.2, 0), 3);
+							log(*pattern - PointF(.2, 0), 3);
+							log(*pattern + PointF(0, .2), 3);
+							log(*pattern - PointF(0, .2), 3);
+							assert(images(inverted).get(pattern->x, pattern->y));
+							pattern->isInverted = inverted;
+							found.add(*pattern);
+						}
+					}
+
+					next.skipPair();
+					next.skipPair();
+					next.extend();
+				}
+			}
 		}
-	}
+	};
 
-	printf("FPs?  : %d\n", N);
+	maxThreads = std::clamp(maxThreads, 1, std::max(1, nbStripes));
 
-	return res;
+	// interleave the stripes so every thread gets a similar share of the image
+	auto scanStripes = [&](int t) {
+		PatternRow row, invRow;
+		for (int stripe = t; stripe < nbStripes; stripe += maxThreads)
+			scanStripe(stripe, row, invRow);
+	};
+	RunOnThreads(maxThreads, scanStripes);
+
+	FinderPatternAreas res;
+	for (auto& stripe : stripes)
+		for (auto& pattern : stripe.patterns())
+			if (!res.contains(pattern))
+				res.add(pattern);
+
+	printf("FPs   : %d\n", Size(res.patterns()));
+
+	return res.patterns();
 }
 
+// A uniform grid over the finder patterns to find the ones near a point without looking at all of them.
+class FinderPatternGrid
+{
+	const FinderPatterns& _patterns;
+	PointF _min;
+	double _cellSize;
+	int _width = 0, _height = 0;
+	std::vector<std::vector<int>> _cells; // indices into _patterns
+
+	PointI cell(PointF p) const
+	{
+		return {std::clamp(int((p.x - _min.x) / _cellSize), 0, _width - 1), std::clamp(int((p.y - _min.y) / _cellSize), 0, _height - 1)};
+	}
+
+public:
+	FinderPatternGrid(const FinderPatterns& patterns, double cellSize) : _patterns(patterns), _cellSize(cellSize)
+	{
+		if (patterns.empty())
+			return;
+		PointF max = _min = patterns.front();
+		for (auto& p : patterns) {
+			_min = {std::min(_min.x, p.x), std::min(_min.y, p.y)};
+			max = {std::max(max.x, p.x), std::max(max.y, p.y)};
+		}
+		_width = int((max.x - _min.x) / _cellSize) + 1;
+		_height = int((max.y - _min.y) / _cellSize) + 1;
+		_cells.resize(_width * _height);
+		for (int i = 0; i < Size(patterns); ++i) {
+			auto c = cell(patterns[i]);
+			_cells[c.y * _width + c.x].push_back(i);
+		}
+	}
+
+	// calls f(i) for all patterns i within radius r around p
+	template <typename F>
+	void forEachWithin(PointF p, double r, F&& f) const
+	{
+		if (_cells.empty())
+			return;
+		auto [x0, y0] = cell(p - PointF(r, r));
+		auto [x1, y1] = cell(p + PointF(r, r));
+		for (int y = y0; y <= y1; ++y)
+			for (int x = x0; x <= x1; ++x)
+				for (int i : _cells[y * _width + x])
+					if (distance(p, _patterns[i]) <= r)
+						f(i);
+	}
+};
+
 /**
  * @brief GenerateFinderPatternSets
  * @param patterns list of ConcentricPattern objects, i.e. found finder pattern squares
@@ -111,28 +233,67 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 {
 	std::sort(patterns.begin(), patterns.end(), [](const auto& a, const auto& b) { return a.size < b.size; });
 
-	auto sets            = std::multimap<double, FinderPatternSet>();
+	auto sets            = std::vector<std::pair<double, FinderPatternSet>>();
 	auto squaredDistance = [](const auto* a, const auto* b) {
 		// The scaling of the distance by the b/a size ratio is a very coarse compensation for the shortening effect of
 		// the camera projection on slanted symbols. The fact that the size of the finder pattern is proportional to the
 		// distance from the camera is used here. This approximation only works if a < b < 2*a (see below).
 		// Test image: fix-finderpattern-order.jpg
+		if (a->size > b->size)
+			std::swap(a, b);
 		return dot((*a - *b), (*a - *b)) * std::pow(double(b->size) / a->size, 2);
 	};
 	const double cosUpper = std::cos(45. / 180 * 3.1415); // TODO: use c++20 std::numbers::pi_v
 	const double cosLower = std::cos(135. / 180 * 3.1415);
 
-	int nbPatterns = Size(patterns);
-	for (int i = 0; i < nbPatterns - 2; i++) {
-		for (int j = i + 1; j < nbPatterns - 1; j++) {
-			for (int k = j + 1; k < nbPatterns - 0; k++) {
-				const auto* a = &patterns[i];
-				const auto* b = &patterns[j];
-				const auto* c = &patterns[k];
+	// The maximal distance between two patterns of a set relative to the size of the smaller one, see the checks below:
+	// the module count limits the sum of the two legs to 2 * (177 * 1.5 - 7) / 7 times the average pattern size, one leg
+	// is at most 2/3 of that sum and the average size is at most 2 times the smallest one.
+	constexpr double MAX_LEG = 2 * (177 * 1.5 - 7) / 7 * 2 / 3 * 2;
+
+	const int nbPatterns = Size(patterns);
+	const FinderPatternGrid grid(patterns, nbPatterns ? 8 * patterns[nbPatterns / 2].size : 1);
+
+	// The patterns that can be on a leg of a symbol with patterns[i] as the corner: they are close enough, their size is
+	// compatible and there is no other pattern in between, like the ones of the neighboring symbol on a label sheet.
+	std::vector<std::vector<int>> legs(nbPatterns);
+	std::vector<int> candidates;
+	for (int i = 0; i < nbPatterns; ++i) {
+		const auto& a = patterns[i];
+		candidates.clear();
+		grid.forEachWithin(a, MAX_LEG * a.size, [&](int j) {
+			const auto& b = patterns[j];
+			if (j != i && a.isInverted == b.isInverted && std::max(a.size, b.size) <= 2 * std::min(a.size, b.size)
+				&& distance(a, b) <= MAX_LEG * std::min(a.size, b.size))
+				candidates.push_back(j);
+		});
+		std::sort(candidates.begin(), candidates.end(), [&](int j, int k) { return distance(a, patterns[j]) < distance(a, patterns[k]); });
+
+		for (int j : candidates) {
+			const auto& b = patterns[j];
+			auto isInBetween = [&](int k) {
+				const auto& c = patterns[k];
+				// a pattern overlapping with a is a false positive rather than part of another symbol
+				if (distance(a, c) < (a.size + c.size) * 3 / 4.)
+					return false;
+				auto ab = b - a;
+				auto t = dot(c - a, ab) / dot(ab, ab);
+				return t > 0 && t < 1 && distance(c, a + t * ab) < (a.size + c.size) / 4.;
+			};
+			if (std::none_of(legs[i].begin(), legs[i].end(), isInBetween))
+				legs[i].push_back(j);
+		}
+	}
+
+	for (int i = 0; i < nbPatterns; ++i) {
+		for (int j = 0; j < Size(legs[i]); ++j) {
+			for (int k = j + 1; k < Size(legs[i]); ++k) {
+				const auto* a = &patterns[legs[i][j]];
+				const auto* b = &patterns[i];
+				const auto* c = &patterns[legs[i][k]];
 				// if the pattern sizes are too different to be part of the same symbol, skip this
-				// and the rest of the innermost loop (sorted list)
-				if (c->size > a->size * 2)
-					break;
+				if (std::max({a->size, b->size, c->size}) > std::min({a->size, b->size, c->size}) * 2)
+					continue;
 
 				// Orders the three points in an order [A,B,C] such that AB is less than AC
 				// and BC is less than AC, and the angle between BC and BA is less than 180 degrees.
@@ -141,13 +302,9 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 				auto distBC2 = squaredDistance(b, c);
 				auto distAC2 = squaredDistance(a, c);
 
-				if (distBC2 >= distAB2 && distBC2 >= distAC2) {
-					std::swap(a, b);
-					std::swap(distBC2, distAC2);
-				} else if (distAB2 >= distAC2 && distAB2 >= distBC2) {
-					std::swap(b, c);
-					std::swap(distAB2, distAC2);
-				}
+				// b has to be the corner, if it is another one, the set is generated from that one (if plausible)
+				if (distAC2 < distAB2 || distAC2 < distBC2)
+					continue;
 
 				auto distAB = std::sqrt(distAB2);
 				auto distBC = std::sqrt(distBC2);
@@ -180,19 +337,13 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 				if (cross(*c - *b, *a - *b) < 0)
 					std::swap(a, c);
 
-				// arbitrarily limit the number of potential sets
-				// (this has performance implications while limiting the maximal number of detected symbols)
-				const auto setSizeLimit = 256;
-				if (sets.size() < setSizeLimit || sets.crbegin()->first > d) {
-					sets.emplace(d, FinderPatternSet{*a, *b, *c});
-					if (sets.size() > setSizeLimit)
-						sets.erase(std::prev(sets.end()));
-				}
+				sets.emplace_back(d, FinderPatternSet{*a, *b, *c});
 			}
 		}
 	}
 
-	// convert from multimap to vector
+	std::stable_sort(sets.begin(), sets.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
 	FinderPatternSets res;
 	res.reserve(sets.size());
 	for (auto& [d, s] : sets)
@@ -343,8 +494,15 @@ static const Version* ReadVersion(const BitMatrix& image, int dimension, const P
 	return Version::DecodeVersionInformation(bits[0], bits[1]);
 }
 
+#ifdef PRINT_DEBUG
+static std::atomic<int> candidateCount = 0, versionRejectedCount = 0; // SampleQR() runs on several threads
+#endif
+
 DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 {
+#ifdef PRINT_DEBUG
+	++candidateCount;
+#endif
 	auto top  = EstimateDimension(image, fp.tl, fp.tr);
 	auto left = EstimateDimension(image, fp.tl, fp.bl);
 
@@ -397,8 +555,12 @@ DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 		auto version = ReadVersion(image, dimension, mod2Pix);
 
 		// if the version bits are garbage -> discard the detection
-		if (!version || std::abs(version->dimension() - dimension) > 8)
+		if (!version || std::abs(version->dimension() - dimension) > 8) {
+#ifdef PRINT_DEBUG
+			printf("version information rejected %d of %d\n", ++versionRejectedCount, candidateCount.load());
+#endif
 			return DetectorResult();
+		}
 		if (version->dimension() != dimension) {
 			printf("update dimension: %d -> %d\n", dimension, version->dimension());
 			dimension = version->dimension();
@@ -665,6 +827,42 @@ DetectorResult DetectPureRMQR(const BitMatrix& image)
 	return {Deflate(image, dimW, dimH, top + moduleSize / 2, left + moduleSize / 2, moduleSize), {tl, tr, br, bl}};
 }
 
+bool IsSingleFinderPatternCandidate(const BitMatrix& image, const ConcentricPattern& fp)
+{
+	// The finder pattern of a Micro QR Code or rMQR Code sits in a corner of the symbol with the quiet zone on the two
+	// outer sides. Looking from the center in 8 directions, at least 3 consecutive ones have to see nothing but white for
+	// 1.5 modules behind the outer ring or leave the image (cropped symbols). A finder pattern like structure somewhere
+	// inside of a symbol or a block of text rarely passes this and is not worth locating the corners and sampling for.
+	constexpr PointI dirs[] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+	const int minWhite = std::max(1, fp.size * 3 / 14);
+
+	bool quiet[Size(dirs)] = {};
+	for (int i = 0; i < Size(dirs); ++i) {
+		auto cur = BitMatrixCursorI(image, PointI(fp), dirs[i]);
+		// pass the center, the white and the black ring of the finder pattern
+		quiet[i] = cur.stepToEdge(3, fp.size) && (!cur.stepToEdge(1, minWhite) || !cur.isIn());
+	}
+
+	for (int i = 0; i < Size(dirs); ++i)
+		if (quiet[i] && quiet[(i + 1) % Size(dirs)] && quiet[(i + 2) % Size(dirs)])
+			return true;
+
+	return false;
+}
+
+// Counts the modules of the timing patterns along the top and left edge of a single finder pattern symbol that do not
+// match, starting behind the separator of the finder pattern up to the given module width/height.
+static int CountTimingPatternErrors(const BitMatrix& image, const PerspectiveTransform& mod2Pix, int width, int height)
+{
+	BitMatrixCursorF cur(image, {}, {});
+	int errors = 0;
+	for (int x = 8; x < width; ++x)
+		errors += cur.blackAt(mod2Pix(centered(PointI{x, 0}))) != (x % 2 == 0);
+	for (int y = 8; y < height; ++y)
+		errors += cur.blackAt(mod2Pix(centered(PointI{0, y}))) != (y % 2 == 0);
+	return errors;
+}
+
 DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp)
 {
 	auto fpQuad = FindConcentricPatternCorners(image, fp, fp.size, 2);
@@ -713,6 +911,12 @@ DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp)
 
 	const int dim = Version::SymbolSize(bestFI.microVersion, Type::Micro).x;
 
+	// the timing patterns along the top and left edge have to be there up to the dimension read from the format info and
+	// not go on into the quiet zone (like the top one of an rMQR Code does)
+	if (CountTimingPatternErrors(image, bestPT, dim, dim) > (dim - 8) / 2 || cur.blackAt(bestPT(centered(PointI{dim + 1, 0})))
+		|| cur.blackAt(bestPT(centered(PointI{0, dim + 1}))))
+		return {};
+
 	// check that we are in fact not looking at a corner of a non-micro QRCode symbol
 	// we accept at most 1/3rd black pixels in the quite zone (in a QRCode symbol we expect about 1/2).
 	int blackPixels = 0;
@@ -774,6 +978,12 @@ DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp)
 
 	const PointI dim = Version::SymbolSize(bestFI.microVersion, Type::rMQR);
 
+	// the timing patterns along the left edge and the top edge have to be there, the latter only as far as the transformation
+	// based on the finder pattern alone is reliable
+	const int timingWidth = std::min(dim.x, 16);
+	if (CountTimingPatternErrors(image, bestPT, timingWidth, dim.y - 1) > (timingWidth - 8 + std::max(0, dim.y - 9)) / 4)
+		return {};
+
 	// TODO: this is a WIP
 	auto intersectQuads = [](QuadrilateralF& a, QuadrilateralF& b) {
 		auto tl = Center(a);
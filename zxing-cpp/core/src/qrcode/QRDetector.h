@@ -27,10 +27,13 @@ struct FinderPatternSet
 using FinderPatterns = std::vector<ConcentricPattern>;
 using FinderPatternSets = std::vector<FinderPatternSet>;
 
-FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder);
+// maxThreads is the number of threads to use (see MaxThreads()), the result does not depend on it
+FinderPatterns FindFinderPatterns(const DualPolarityBitMatrix& images, bool tryHarder, int maxThreads = 1);
 FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns);
 
 DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp);
+// cheap test whether fp can be the finder pattern of a Micro QR Code or rMQR Code, to be done before sampling it below
+bool IsSingleFinderPatternCandidate(const BitMatrix& image, const ConcentricPattern& fp);
 DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp);
 DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp);
 
@@ -21,6 +21,8 @@
 #include <array>
 #include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace ZXing::QRCode {
 
@@ -204,10 +206,8 @@ void Append8BitBytes(const std::wstring& content, CharacterSet encoding, BitArra
 	}
 }
 
-ZXING_EXPORT_TEST_ONLY
-void AppendKanjiBytes(const std::wstring& content, BitArray& bits)
+static void AppendShiftJISKanji(const std::string& bytes, BitArray& bits)
 {
-	std::string bytes = TextEncoder::FromUnicode(content, CharacterSet::Shift_JIS);
 	int length = Size(bytes);
 	if (length % 2 != 0) {
 		throw std::invalid_argument("Kanji byte size not even");
@@ -232,6 +232,12 @@ void AppendKanjiBytes(const std::wstring& content, BitArray& bits)
 	}
 }
 
+ZXING_EXPORT_TEST_ONLY
+void AppendKanjiBytes(const std::wstring& content, BitArray& bits)
+{
+	AppendShiftJISKanji(TextEncoder::FromUnicode(content, CharacterSet::Shift_JIS), bits);
+}
+
 /**
 * Append "bytes" in "mode" mode (encoding) into "bits". On success, store the result in "bits".
 */
@@ -442,14 +448,14 @@ BitArray InterleaveWithECBytes(const BitArray& bits, int numTotalBytes, int numD
 }
 
 
-static int ChooseMaskPattern(const BitArray& bits, ErrorCorrectionLevel ecLevel, const Version& version, TritMatrix& matrix)
+static int ChooseMaskPattern(const BitArray& bits, ErrorCorrectionLevel ecLevel, const Version& version)
 {
 	int minPenalty = std::numeric_limits<int>::max();  // Lower penalty is better.
 	int bestMaskPattern = -1;
 	// We try all mask patterns to choose the best one.
+	auto matrices = BuildMatrices(bits, ecLevel, version);
 	for (int maskPattern = 0; maskPattern < NUM_MASK_PATTERNS; maskPattern++) {
-		BuildMatrix(bits, ecLevel, version, maskPattern, matrix);
-		int penalty = MaskUtil::CalculateMaskPenalty(matrix);
+		int penalty = MaskUtil::CalculateMaskPenalty(matrices[maskPattern]);
 		if (penalty < minPenalty) {
 			minPenalty = penalty;
 			bestMaskPattern = maskPattern;
@@ -480,6 +486,36 @@ static const Version& RecommendVersion(ErrorCorrectionLevel ecLevel, CodecMode m
 	return ChooseVersion(bitsNeeded, ecLevel);
 }
 
+static EncodeResult BuildEncodeResult(BitArray&& headerAndDataBits, ErrorCorrectionLevel ecLevel, const Version& version,
+									  CodecMode mode, int maskPattern)
+{
+	auto& ecBlocks = version.ecBlocksForLevel(ecLevel);
+	int numDataBytes = version.totalCodewords() - ecBlocks.totalCodewords();
+
+	// Terminate the bits properly.
+	TerminateBits(numDataBytes, headerAndDataBits);
+
+	// Interleave data bits with error correction code.
+	BitArray finalBits = InterleaveWithECBytes(headerAndDataBits, version.totalCodewords(), numDataBytes, ecBlocks.numBlocks());
+
+	EncodeResult output;
+	output.ecLevel = ecLevel;
+	output.mode = mode;
+	output.version = &version;
+
+	//  Choose the mask pattern and set to "qrCode".
+	int dimension = version.dimension();
+	TritMatrix matrix(dimension, dimension);
+	output.maskPattern = maskPattern != -1 ? maskPattern : ChooseMaskPattern(finalBits, ecLevel, version);
+
+	// Build the matrix and set it to "qrCode".
+	BuildMatrix(finalBits, ecLevel, version, output.maskPattern, matrix);
+
+	output.matrix = ToBitMatrix(matrix);
+
+	return output;
+}
+
 EncodeResult Encode(const std::wstring& content, ErrorCorrectionLevel ecLevel, CharacterSet charset, int versionNumber,
 					bool useGs1Format, int maskPattern)
 {
@@ -540,32 +576,217 @@ EncodeResult Encode(const std::wstring& content, ErrorCorrectionLevel ecLevel, C
 	// Put data together into the overall payload
 	headerAndDataBits.appendBitArray(dataBits);
 
-	auto& ecBlocks = version->ecBlocksForLevel(ecLevel);
-	int numDataBytes = version->totalCodewords() - ecBlocks.totalCodewords();
+	return BuildEncodeResult(std::move(headerAndDataBits), ecLevel, *version, mode, maskPattern);
+}
 
-	// Terminate the bits properly.
-	TerminateBits(numDataBytes, headerAndDataBits);
+struct CharInfo
+{
+	int size;          // number of UTF-8 bytes
+	int numBytes;      // number of bytes in byte mode, 0 if it can't be encoded in the character set
+	bool isDigit;
+	bool isAlphanumeric;
+	bool isKanji;
+};
 
-	// Interleave data bits with error correction code.
-	BitArray finalBits =
-		InterleaveWithECBytes(headerAndDataBits, version->totalCodewords(), numDataBytes, ecBlocks.numBlocks());
+struct Segment
+{
+	CodecMode mode;
+	std::string_view text; // UTF-8
+};
 
-	EncodeResult output;
-	output.ecLevel = ecLevel;
-	output.mode = mode;
-	output.version = version;
+static std::vector<CharInfo> AnalyzeChars(std::string_view content, CharacterSet charset, bool allowKanji, bool useGs1Format)
+{
+	// ASCII is a single byte in all character sets apart from the UTF-16/32 ones
+	bool isAsciiCompatible = charset != CharacterSet::UTF16BE && charset != CharacterSet::UTF16LE && charset != CharacterSet::UTF32BE
+							 && charset != CharacterSet::UTF32LE;
+
+	auto encode = [](std::string_view c, CharacterSet cs) {
+		try {
+			return TextEncoder::FromUnicode(std::string(c), cs);
+		} catch (std::invalid_argument&) {
+			return std::string();
+		}
+	};
+
+	std::vector<CharInfo> res;
+	res.reserve(content.size());
+	for (size_t i = 0; i < content.size();) {
+		uint8_t lead = content[i];
+		int size = std::min<int>(lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4, Size(content) - narrow_cast<int>(i));
+		auto c = content.substr(i, size);
+		CharInfo info = {size, size, false, false, false};
+		if (lead < 0x80) {
+			info.isDigit = lead >= '0' && lead <= '9';
+			// in FNC1 mode a '%' in an alphanumeric segment stands for a GS character
+			info.isAlphanumeric = GetAlphanumericCode(lead) != -1 && !(useGs1Format && lead == '%');
+			if (!isAsciiCompatible)
+				info.numBytes = Size(encode(c, charset));
+		} else {
+			if (charset != CharacterSet::UTF8)
+				info.numBytes = Size(encode(c, charset));
+			if (allowKanji) {
+				auto sjis = encode(c, CharacterSet::Shift_JIS);
+				int byte1 = Size(sjis) == 2 ? uint8_t(sjis[0]) : 0;
+				info.isKanji = (byte1 >= 0x81 && byte1 <= 0x9F) || (byte1 >= 0xE0 && byte1 <= 0xEB);
+			}
+		}
+		res.push_back(info);
+		i += size;
+	}
+	return res;
+}
 
-	//  Choose the mask pattern and set to "qrCode".
-	int dimension = version->dimension();
-	TritMatrix matrix(dimension, dimension);
-	output.maskPattern = maskPattern != -1 ? maskPattern : ChooseMaskPattern(finalBits, ecLevel, *version, matrix);
+/**
+* Split the content into the sequence of Numeric, Alphanumeric, Byte and Kanji segments that needs the least number of bits
+* in a symbol of the given version. Only the number of character count bits depends on the version, which changes at
+* version 10 and 27.
+*/
+static std::vector<Segment> ChooseSegments(std::string_view content, const std::vector<CharInfo>& chars, const Version& version)
+{
+	constexpr CodecMode MODES[] = {CodecMode::NUMERIC, CodecMode::ALPHANUMERIC, CodecMode::BYTE, CodecMode::KANJI};
+	constexpr int NUM_MODES = Size(MODES);
+	constexpr int INF = std::numeric_limits<int>::max() / 2;
+
+	// All costs are in 1/6 bits, so a digit (10 bits per 3) and an alphanumeric character (11 bits per 2) cost an integral
+	// amount. A segment is rounded up to full bits when it ends.
+	auto charCost = [](const CharInfo& c, int mode) {
+		switch (mode) {
+		case 0: return c.isDigit ? 20 : INF;
+		case 1: return c.isAlphanumeric ? 33 : INF;
+		case 2: return c.numBytes ? 48 * c.numBytes : INF;
+		default: return c.isKanji ? 78 : INF;
+		}
+	};
+	auto roundUp = [](int cost) { return (cost + 5) / 6 * 6; };
+
+	int headerCost[NUM_MODES];
+	for (int m = 0; m < NUM_MODES; ++m)
+		headerCost[m] = 6 * (4 + CharacterCountBits(MODES[m], version));
+
+	// cost[i][m]: the least cost of the first i characters with character i - 1 in a segment of mode m
+	// prev[i][m]: the mode of character i - 2 in that case
+	int n = Size(chars);
+	std::vector<std::array<int, NUM_MODES>> cost(n + 1), prev(n + 1);
+	cost[0].fill(0);
+	for (int i = 0; i < n; ++i)
+		for (int m = 0; m < NUM_MODES; ++m) {
+			cost[i + 1][m] = INF;
+			int c = charCost(chars[i], m);
+			if (c == INF)
+				continue;
+			for (int p = 0; p < NUM_MODES; ++p) {
+				if (cost[i][p] >= INF || (i == 0 && p != m))
+					continue;
+				int total = p == m && i > 0 ? cost[i][p] + c : roundUp(cost[i][p]) + headerCost[m] + c;
+				if (total < cost[i + 1][m]) {
+					cost[i + 1][m] = total;
+					prev[i + 1][m] = p;
+				}
+			}
+		}
 
-	// Build the matrix and set it to "qrCode".
-	BuildMatrix(finalBits, ecLevel, *version, output.maskPattern, matrix);
+	int mode = 0;
+	for (int m = 1; m < NUM_MODES; ++m)
+		if (roundUp(cost[n][m]) < roundUp(cost[n][mode]))
+			mode = m;
+	if (n > 0 && cost[n][mode] >= INF)
+		throw std::invalid_argument("Unexpected charcode");
+
+	// walk back and merge the characters into segments
+	std::vector<Segment> res;
+	size_t end = content.size();
+	for (int i = n; i > 0; --i) {
+		end -= chars[i - 1].size;
+		if (res.empty() || res.back().mode != MODES[mode])
+			res.push_back({MODES[mode], content.substr(end, 0)});
+		res.back().text = content.substr(end, res.back().text.size() + chars[i - 1].size);
+		mode = prev[i][mode];
+	}
+	std::reverse(res.begin(), res.end());
+	return res;
+}
 
-	output.matrix = ToBitMatrix(matrix);
+static void AppendSegment(const Segment& segment, CharacterSet charset, const Version& version, BitArray& bits)
+{
+	AppendModeInfo(segment.mode, bits);
+	switch (segment.mode) {
+	case CodecMode::NUMERIC:
+	case CodecMode::ALPHANUMERIC: {
+		std::wstring ascii(segment.text.begin(), segment.text.end());
+		AppendLengthInfo(Size(ascii), version, segment.mode, bits);
+		AppendBytes(ascii, segment.mode, charset, bits);
+		break;
+	}
+	case CodecMode::BYTE: {
+		auto bytes = charset == CharacterSet::UTF8 ? std::string(segment.text) : TextEncoder::FromUnicode(std::string(segment.text), charset);
+		AppendLengthInfo(Size(bytes), version, segment.mode, bits);
+		for (char b : bytes)
+			bits.appendBits(b, 8);
+		break;
+	}
+	default: {
+		auto bytes = TextEncoder::FromUnicode(std::string(segment.text), CharacterSet::Shift_JIS);
+		AppendLengthInfo(Size(bytes) / 2, version, segment.mode, bits);
+		AppendShiftJISKanji(bytes, bits);
+	}
+	}
+}
 
-	return output;
+EncodeResult EncodeCompact(std::string_view content, ErrorCorrectionLevel ecLevel, CharacterSet charset, int versionNumber,
+						   bool useGs1Format, int maskPattern)
+{
+	bool charsetWasUnknown = charset == CharacterSet::Unknown;
+	if (charsetWasUnknown) {
+		charset = DEFAULT_BYTE_MODE_ENCODING;
+	}
+
+	// Kanji segments are decoded as Shift_JIS, which would be overruled by any other ECI designator.
+	bool allowKanji = charsetWasUnknown || charset == CharacterSet::Shift_JIS;
+	auto chars = AnalyzeChars(content, charset, allowKanji, useGs1Format);
+
+	const Version* requestedVersion = versionNumber > 0 ? Version::Model2(versionNumber) : nullptr;
+
+	// The segmentation is optimal for all versions with the same number of character count bits.
+	int minVersionNumber = 1;
+	for (int maxVersionNumber : {9, 26, 40}) {
+		if (requestedVersion && requestedVersion->versionNumber() > maxVersionNumber) {
+			minVersionNumber = maxVersionNumber + 1;
+			continue;
+		}
+
+		const Version& rangeVersion = requestedVersion ? *requestedVersion : *Version::Model2(maxVersionNumber);
+		auto segments = ChooseSegments(content, chars, rangeVersion);
+
+		BitArray headerAndDataBits;
+		bool hasByteSegment = std::any_of(segments.begin(), segments.end(), [](auto& s) { return s.mode == CodecMode::BYTE; });
+		if (hasByteSegment && !charsetWasUnknown) {
+			AppendECI(charset, headerAndDataBits);
+		}
+		if (useGs1Format) {
+			AppendModeInfo(CodecMode::FNC1_FIRST_POSITION, headerAndDataBits);
+		}
+		for (auto& segment : segments) {
+			AppendSegment(segment, charset, rangeVersion, headerAndDataBits);
+		}
+
+		CodecMode mode = segments.empty() ? CodecMode::BYTE : segments.front().mode;
+
+		if (requestedVersion) {
+			if (!WillFit(headerAndDataBits.size(), *requestedVersion, ecLevel)) {
+				throw std::invalid_argument("Data too big for requested version");
+			}
+			return BuildEncodeResult(std::move(headerAndDataBits), ecLevel, *requestedVersion, mode, maskPattern);
+		}
+
+		for (int number = minVersionNumber; number <= maxVersionNumber; ++number) {
+			const Version& version = *Version::Model2(number);
+			if (WillFit(headerAndDataBits.size(), version, ecLevel)) {
+				return BuildEncodeResult(std::move(headerAndDataBits), ecLevel, version, mode, maskPattern);
+			}
+		}
+		minVersionNumber = maxVersionNumber + 1;
+	}
+	throw std::invalid_argument("Data too big");
 }
 
 } // namespace ZXing::QRCode
@@ -9,6 +9,7 @@
 #include "CharacterSet.h"
 
 #include <string>
+#include <string_view>
 
 namespace ZXing::QRCode {
 
@@ -18,4 +19,11 @@ class EncodeResult;
 EncodeResult Encode(const std::wstring& content, ErrorCorrectionLevel ecLevel, CharacterSet encoding, int versionNumber,
 					bool useGs1Format, int maskPattern = -1);
 
+/**
+ * Same as above but the UTF-8 content is split into the sequence of Numeric, Alphanumeric, Byte and Kanji segments that
+ * needs the least number of bits. Kanji segments are only used if the encoding is Unknown or Shift_JIS.
+ */
+EncodeResult EncodeCompact(std::string_view content, ErrorCorrectionLevel ecLevel, CharacterSet encoding, int versionNumber,
+						   bool useGs1Format, int maskPattern = -1);
+
 } // namespace ZXing::QRCode
@@ -11,6 +11,8 @@
 #include "BitHacks.h"
 #include "ZXAlgorithms.h"
 
+#include <initializer_list>
+
 namespace ZXing::QRCode {
 
 static uint32_t MirrorBits(uint32_t bits)
@@ -18,7 +20,7 @@ static uint32_t MirrorBits(uint32_t bits)
 	return BitHacks::Reverse(bits) >> 17;
 }
 
-static FormatInformation FindBestFormatInfo(const std::vector<uint32_t>& masks, const std::vector<uint32_t>& bits)
+static FormatInformation FindBestFormatInfo(std::initializer_list<uint32_t> masks, std::initializer_list<uint32_t> bits)
 {
 	// See ISO 18004:2015, Annex C, Table C.1
 	constexpr uint32_t MODEL2_MASKED_PATTERNS[] = {
@@ -34,7 +36,7 @@ static FormatInformation FindBestFormatInfo(const std::vector<uint32_t>& masks,
 				// 'unmask' the pattern first to get the original 5-data bits + 10-ec bits back
 				pattern ^= FORMAT_INFO_MASK_MODEL2;
 				// Find the pattern with fewest bits differing
-				if (int hammingDist = BitHacks::CountBitsSet((bits[bitsIndex] ^ mask) ^ pattern);
+				if (int hammingDist = BitHacks::CountBitsSet((bits.begin()[bitsIndex] ^ mask) ^ pattern);
 					hammingDist < fi.hammingDistance) {
 					fi.mask = mask; // store the used mask to discriminate between types/models
 					fi.data = pattern >> 10; // drop the 10 BCH error correction bits
@@ -46,7 +48,7 @@ static FormatInformation FindBestFormatInfo(const std::vector<uint32_t>& masks,
 	return fi;
 }
 
-static FormatInformation FindBestFormatInfoRMQR(const std::vector<uint32_t>& bits, const std::vector<uint32_t>& subbits)
+static FormatInformation FindBestFormatInfoRMQR(std::initializer_list<uint32_t> bits, std::initializer_list<uint32_t> subbits)
 {
 	// See ISO/IEC 23941:2022, Annex C, Table C.1 - Valid format information sequences
 	constexpr uint32_t MASKED_PATTERNS[64] = { // Finder pattern side
@@ -72,14 +74,14 @@ static FormatInformation FindBestFormatInfoRMQR(const std::vector<uint32_t>& bit
 
 	FormatInformation fi;
 
-	auto best = [&fi](const std::vector<uint32_t>& bits, const uint32_t (&patterns)[64], uint32_t mask)
+	auto best = [&fi](std::initializer_list<uint32_t> bits, const uint32_t (&patterns)[64], uint32_t mask)
 	{
 		for (int bitsIndex = 0; bitsIndex < Size(bits); ++bitsIndex)
 			for (uint32_t pattern : patterns) {
 				// 'unmask' the pattern first to get the original 6-data bits + 12-ec bits back
 				pattern ^= mask;
 				// Find the pattern with fewest bits differing
-				if (int hammingDist = BitHacks::CountBitsSet((bits[bitsIndex] ^ mask) ^ pattern);
+				if (int hammingDist = BitHacks::CountBitsSet((bits.begin()[bitsIndex] ^ mask) ^ pattern);
 					hammingDist < fi.hammingDistance) {
 					fi.mask = mask; // store the used mask to discriminate between types/models
 					fi.data = pattern >> 12; // drop the 12 BCH error correction bits
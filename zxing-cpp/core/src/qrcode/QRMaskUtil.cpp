@@ -6,6 +6,8 @@
 
 #include "QRMaskUtil.h"
 
+#include "BitHacks.h"
+
 #include <algorithm>
 #include <array>
 #include <cassert>
@@ -129,6 +131,12 @@ static int ApplyMaskPenaltyRule3(const TritMatrix& matrix)
 	return numPenalties * N3;
 }
 
+static int PenaltyRule4(int numDarkCells, int numTotalCells)
+{
+	int fivePercentVariances = std::abs(numDarkCells * 2 - numTotalCells) * 10 / numTotalCells;
+	return fivePercentVariances * N4;
+}
+
 /**
 * Apply mask penalty rule 4 and return the penalty. Calculate the ratio of dark cells and give
 * penalty if the ratio is far from 50%. It gives 10 penalty for 5% distance.
@@ -136,9 +144,7 @@ static int ApplyMaskPenaltyRule3(const TritMatrix& matrix)
 static int ApplyMaskPenaltyRule4(const TritMatrix& matrix)
 {
 	auto numDarkCells = std::count_if(matrix.begin(), matrix.end(), [](Trit cell) { return cell; });
-	auto numTotalCells = matrix.size();
-	auto fivePercentVariances = std::abs(numDarkCells * 2 - numTotalCells) * 10 / numTotalCells;
-	return narrow_cast<int>(fivePercentVariances * N4);
+	return PenaltyRule4(narrow_cast<int>(numDarkCells), matrix.size());
 }
 
 // The mask penalty calculation is complicated.  See Table 21 of JISX0510:2004 (p.45) for details.
@@ -151,4 +157,109 @@ int CalculateMaskPenalty(const TritMatrix& matrix)
 		   + MaskUtil::ApplyMaskPenaltyRule4(matrix);
 }
 
+PackedMatrix::PackedMatrix(const TritMatrix& matrix) : PackedMatrix(matrix.width(), matrix.height())
+{
+	for (int y = 0; y < _height; ++y)
+		for (int x = 0; x < _width; ++x)
+			if (matrix.get(x, y))
+				_rows[y][x / 64] |= uint64_t(1) << (x % 64);
+}
+
+/*
+ * The rules below are evaluated on a whole word of a row at once. Modules outside of the symbol are 0 (white) in the packed
+ * rows, which is what the rules above assume for the quiet zone as well.
+ */
+using Row = PackedMatrix::Row;
+constexpr int WORDS = PackedMatrix::WORDS_PER_ROW;
+
+// word i of the row shifted by n modules, so that bit x is module x + n
+static uint64_t Shifted(const Row& row, int i, int n)
+{
+	if (n > 0)
+		return (row[i] >> n) | (i + 1 < WORDS ? row[i + 1] << (64 - n) : 0);
+	else
+		return (row[i] << -n) | (i > 0 ? row[i - 1] >> (64 + n) : 0);
+}
+
+static int CountBitsSet(uint64_t word)
+{
+	return word ? BitHacks::CountBitsSet(uint32_t(word)) + BitHacks::CountBitsSet(uint32_t(word >> 32)) : 0;
+}
+
+// the modules 0..n-1
+static Row FirstModules(int n)
+{
+	Row res = {};
+	for (int i = 0; i < WORDS; ++i)
+		res[i] = n >= 64 * (i + 1) ? ~uint64_t(0) : n > 64 * i ? (uint64_t(1) << (n - 64 * i)) - 1 : 0;
+	return res;
+}
+
+int CalculateMaskPenalty(const PackedMatrix& matrix)
+{
+	const int width = matrix.width(), height = matrix.height();
+	const Row inside = FirstModules(width), allButLast = FirstModules(width - 1), outside = {};
+	auto row = [&](int y) -> const Row& { return y >= 0 && y < height ? matrix.row(y) : outside; };
+
+	// modules with the same color as the one to the right / below
+	std::vector<Row> sameRight(height), sameBelow(std::max(0, height - 1));
+	for (int y = 0; y < height; ++y)
+		for (int i = 0; i < WORDS; ++i) {
+			sameRight[y][i] = ~(row(y)[i] ^ Shifted(row(y), i, 1)) & allButLast[i];
+			if (y + 1 < height)
+				sameBelow[y][i] = ~(row(y)[i] ^ row(y + 1)[i]) & inside[i];
+		}
+
+	// A run of L >= 5 modules (rule 1) contains L - 4 places with 4 modules in a row that have the same color as the next
+	// one. Its penalty N1 + (L - 5) is the number of those places plus N1 - 1 for the first one.
+	int numRunPlaces = 0, numRuns = 0, num2x2Blocks = 0, numFinderPatterns = 0, numDarkCells = 0;
+	Row placesAbove = {};
+	for (int y = 0; y < height; ++y) {
+		const auto& r = matrix.row(y);
+		const auto& same = sameRight[y];
+
+		Row places;
+		for (int i = 0; i < WORDS; ++i)
+			places[i] = same[i] & Shifted(same, i, 1) & Shifted(same, i, 2) & Shifted(same, i, 3);
+
+		for (int i = 0; i < WORDS; ++i) {
+			numRunPlaces += CountBitsSet(places[i]);
+			numRuns += CountBitsSet(places[i] & ~Shifted(places, i, -1));
+
+			if (y + 4 < height) {
+				auto placesBelow = sameBelow[y][i] & sameBelow[y + 1][i] & sameBelow[y + 2][i] & sameBelow[y + 3][i];
+				numRunPlaces += CountBitsSet(placesBelow);
+				numRuns += CountBitsSet(placesBelow & ~placesAbove[i]);
+				placesAbove[i] = placesBelow;
+			}
+
+			if (y + 1 < height)
+				num2x2Blocks += CountBitsSet(same[i] & sameRight[y + 1][i] & sameBelow[y][i]);
+
+			// 1:1:3:1:1 patterns (rule 3) in both directions
+			auto finder = r[i] & ~Shifted(r, i, 1) & Shifted(r, i, 2) & Shifted(r, i, 3) & Shifted(r, i, 4) & ~Shifted(r, i, 5)
+						  & Shifted(r, i, 6);
+			if (finder) {
+				auto whiteBefore = ~(Shifted(r, i, -1) | Shifted(r, i, -2) | Shifted(r, i, -3) | Shifted(r, i, -4));
+				auto whiteAfter = ~(Shifted(r, i, 7) | Shifted(r, i, 8) | Shifted(r, i, 9) | Shifted(r, i, 10));
+				numFinderPatterns += CountBitsSet(finder & (whiteBefore | whiteAfter));
+			}
+
+			finder = r[i] & ~row(y + 1)[i] & row(y + 2)[i] & row(y + 3)[i] & row(y + 4)[i] & ~row(y + 5)[i] & row(y + 6)[i];
+			if (finder) {
+				auto whiteBefore = ~(row(y - 1)[i] | row(y - 2)[i] | row(y - 3)[i] | row(y - 4)[i]);
+				auto whiteAfter = ~(row(y + 7)[i] | row(y + 8)[i] | row(y + 9)[i] | row(y + 10)[i]);
+				numFinderPatterns += CountBitsSet(finder & (whiteBefore | whiteAfter));
+			}
+
+			numDarkCells += CountBitsSet(r[i]);
+		}
+	}
+
+	return numRunPlaces + (N1 - 1) * numRuns
+		   + N2 * num2x2Blocks
+		   + N3 * numFinderPatterns
+		   + PenaltyRule4(numDarkCells, width * height);
+}
+
 } // namespace ZXing::QRCode::MaskUtil
@@ -6,10 +6,57 @@
 
 #pragma once
 
+#include "Point.h"
 #include "TritMatrix.h"
 
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
 namespace ZXing::QRCode::MaskUtil {
 
+/**
+ * A matrix of modules with each row packed into words (module x is bit x % 64 of word x / 64), which allows to evaluate
+ * the mask penalty rules for a whole row at once. Symbols up to version 40 (177 modules) fit.
+ */
+class PackedMatrix
+{
+public:
+	static constexpr int WORDS_PER_ROW = 3;
+	using Row = std::array<uint64_t, WORDS_PER_ROW>;
+
+private:
+	int _width = 0;
+	int _height = 0;
+	std::vector<Row> _rows;
+
+public:
+	PackedMatrix() = default;
+	PackedMatrix(int width, int height) : _width(width), _height(height), _rows(height, Row{})
+	{
+		assert(width <= 64 * WORDS_PER_ROW);
+	}
+	explicit PackedMatrix(const TritMatrix& matrix);
+
+	int width() const { return _width; }
+	int height() const { return _height; }
+
+	const Row& row(int y) const { return _rows[y]; }
+	Row& row(int y) { return _rows[y]; }
+
+	bool get(int x, int y) const { return (_rows[y][x / 64] >> (x % 64)) & 1; }
+	void set(int x, int y, bool value)
+	{
+		auto& word = _rows[y][x / 64];
+		word = (word & ~(uint64_t(1) << (x % 64))) | (uint64_t(value) << (x % 64));
+	}
+	void set(PointI p, bool value) { set(p.x, p.y, value); }
+};
+
 int CalculateMaskPenalty(const TritMatrix& matrix);
 
+// Same as above, only a lot faster.
+int CalculateMaskPenalty(const PackedMatrix& matrix);
+
 } // namespace ZXing::QRCode::MaskUtil
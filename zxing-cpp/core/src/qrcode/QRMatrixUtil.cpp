@@ -10,6 +10,7 @@
 #include "BitHacks.h"
 #include "QRDataMask.h"
 #include "QRErrorCorrectionLevel.h"
+#include "QRMaskUtil.h"
 #include "QRVersion.h"
 
 #include <stdexcept>
@@ -181,7 +182,8 @@ static BitArray MakeTypeInfoBits(ErrorCorrectionLevel ecLevel, int maskPattern)
 }
 
 // Embed type information. On success, modify the matrix.
-static void EmbedTypeInfo(ErrorCorrectionLevel ecLevel, int maskPattern, TritMatrix& matrix)
+template <typename MATRIX>
+static void EmbedTypeInfo(ErrorCorrectionLevel ecLevel, int maskPattern, MATRIX& matrix)
 {
 	// Type info cells at the left top corner.
 	constexpr PointI TYPE_INFO_COORDINATES[] = {
@@ -294,9 +296,8 @@ static void EmbedDataBits(const BitArray& dataBits, int maskPattern, TritMatrix&
 	}
 }
 
-// Build 2D matrix of QR Code from "dataBits" with "ecLevel", "version" and "getMaskPattern". On
-// success, store the result in "matrix" and return true.
-void BuildMatrix(const BitArray& dataBits, ErrorCorrectionLevel ecLevel, const Version& version, int maskPattern, TritMatrix& matrix)
+// Embed everything but the data bits.
+static void EmbedFunctionPatterns(ErrorCorrectionLevel ecLevel, const Version& version, int maskPattern, TritMatrix& matrix)
 {
 	matrix.clear();
 	// Let's get started with embedding big squares at corners.
@@ -311,8 +312,61 @@ void BuildMatrix(const BitArray& dataBits, ErrorCorrectionLevel ecLevel, const V
 	EmbedTypeInfo(ecLevel, maskPattern, matrix);
 	// Version info appear if version >= 7.
 	EmbedVersionInfo(version, matrix);
+}
+
+// Build 2D matrix of QR Code from "dataBits" with "ecLevel", "version" and "getMaskPattern". On
+// success, store the result in "matrix" and return true.
+void BuildMatrix(const BitArray& dataBits, ErrorCorrectionLevel ecLevel, const Version& version, int maskPattern, TritMatrix& matrix)
+{
+	EmbedFunctionPatterns(ecLevel, version, maskPattern, matrix);
 	// Data should be embedded at end.
 	EmbedDataBits(dataBits, maskPattern, matrix);
 }
 
+// The data mask patterns repeat every 12 rows.
+static const MaskUtil::PackedMatrix::Row& DataMaskRow(int maskPattern, int y)
+{
+	static const auto masks = [] {
+		std::array<MaskUtil::PackedMatrix, NUM_MASK_PATTERNS> res;
+		for (int i = 0; i < NUM_MASK_PATTERNS; ++i) {
+			res[i] = MaskUtil::PackedMatrix(64 * MaskUtil::PackedMatrix::WORDS_PER_ROW, 12);
+			for (int y = 0; y < res[i].height(); ++y)
+				for (int x = 0; x < res[i].width(); ++x)
+					res[i].set(x, y, GetDataMaskBit(i, x, y));
+		}
+		return res;
+	}();
+	return masks[maskPattern].row(y % 12);
+}
+
+std::array<MaskUtil::PackedMatrix, NUM_MASK_PATTERNS> BuildMatrices(const BitArray& dataBits, ErrorCorrectionLevel ecLevel,
+																	const Version& version)
+{
+	// The matrices only differ in the data modules, which are XORed with the mask pattern, and the type information. So
+	// the data bits are embedded only once without mask and the modules left empty by the function patterns are remembered.
+	TritMatrix matrix(version.dimension(), version.dimension());
+	EmbedFunctionPatterns(ecLevel, version, 0, matrix);
+
+	MaskUtil::PackedMatrix dataModules(matrix.width(), matrix.height());
+	for (int y = 0; y < matrix.height(); ++y)
+		for (int x = 0; x < matrix.width(); ++x)
+			dataModules.set(x, y, matrix.get(x, y).isEmpty());
+
+	EmbedDataBits(dataBits, -1, matrix);
+	const MaskUtil::PackedMatrix unmasked(matrix);
+
+	std::array<MaskUtil::PackedMatrix, NUM_MASK_PATTERNS> res;
+	for (int maskPattern = 0; maskPattern < NUM_MASK_PATTERNS; ++maskPattern) {
+		res[maskPattern] = unmasked;
+		for (int y = 0; y < matrix.height(); ++y) {
+			auto& row = res[maskPattern].row(y);
+			const auto& mask = DataMaskRow(maskPattern, y);
+			for (int i = 0; i < Size(row); ++i)
+				row[i] ^= dataModules.row(y)[i] & mask[i];
+		}
+		EmbedTypeInfo(ecLevel, maskPattern, res[maskPattern]);
+	}
+	return res;
+}
+
 } // namespace ZXing::QRCode
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include "QRMaskUtil.h"
 #include "TritMatrix.h"
 
+#include <array>
+
 namespace ZXing {
 
 class BitArray;
@@ -21,5 +24,9 @@ constexpr int NUM_MASK_PATTERNS = 8;
 
 void BuildMatrix(const BitArray& dataBits, ErrorCorrectionLevel ecLevel, const Version& version, int maskPattern, TritMatrix& matrix);
 
+// Build the matrices for all mask patterns at once, the same as BuildMatrix() for each of them, only in packed form.
+std::array<MaskUtil::PackedMatrix, NUM_MASK_PATTERNS> BuildMatrices(const BitArray& dataBits, ErrorCorrectionLevel ecLevel,
+																	const Version& version);
+
 } // QRCode
 } // ZXing
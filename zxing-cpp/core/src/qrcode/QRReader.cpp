@@ -16,6 +16,7 @@
 #include "QRDecoder.h"
 #include "QRDetector.h"
 #include "Barcode.h"
+#include "ZXThreads.h"
 
 #include <utility>
 
@@ -77,7 +78,10 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
 #endif
 	
-	auto allFPs = FindFinderPatterns(*binImg, _opts.tryHarder());
+	// inverted symbols are looked for in the same pass, instead of a second one over the inverted image (see findsInverted)
+	DualPolarityBitMatrix images(*binImg, findsInverted() && !image.inverted());
+	// the finder patterns are searched once and used for all QR code variants below
+	auto allFPs = FindFinderPatterns(images, _opts.tryHarder(), MaxThreads(_opts));
 
 #ifdef PRINT_DEBUG
 	printf("allFPs: %d\n", Size(allFPs));
@@ -94,7 +98,7 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 
 			logFPSet(fpSet);
 
-			auto detectorResult = SampleQR(*binImg, fpSet);
+			auto detectorResult = SampleQR(images(fpSet.tl.isInverted), fpSet);
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if (decoderResult.isValid()) {
@@ -104,6 +108,7 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 				}
 				if (decoderResult.isValid(_opts.returnErrors())) {
 					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::QRCode);
+					SetIsInverted(res.back(), fpSet.tl.isInverted);
 					if (maxSymbols && Size(res) == maxSymbols)
 						break;
 				}
@@ -111,16 +116,28 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 		}
 	}
 	
-	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
-		for (const auto& fp : allFPs) {
-			if (Contains(usedFPs, fp))
-				continue;
+	// Micro QR Code and rMQR Code symbols have a single finder pattern, only the ones with a quiet zone around one corner
+	// are worth sampling
+	FinderPatterns singleFPs;
+	if (_opts.hasFormat(BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode) && !(maxSymbols && Size(res) == maxSymbols))
+		for (const auto& fp : allFPs)
+			if (!Contains(usedFPs, fp) && IsSingleFinderPatternCandidate(images(fp.isInverted), fp))
+				singleFPs.push_back(fp);
 
-			auto detectorResult = SampleMQR(*binImg, fp);
+#ifdef PRINT_DEBUG
+	printf("singleFPs: %d\n", Size(singleFPs));
+#endif
+
+	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
+		for (const auto& fp : singleFPs) {
+			auto detectorResult = SampleMQR(images(fp.isInverted), fp);
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
+				if (decoderResult.isValid())
+					usedFPs.push_back(fp);
 				if (decoderResult.isValid(_opts.returnErrors())) {
 					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::MicroQRCode);
+					SetIsInverted(res.back(), fp.isInverted);
 					if (maxSymbols && Size(res) == maxSymbols)
 						break;
 				}
@@ -130,16 +147,16 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	}
 	
 	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
-		// TODO proper
-		for (const auto& fp : allFPs) {
+		for (const auto& fp : singleFPs) {
 			if (Contains(usedFPs, fp))
 				continue;
 
-			auto detectorResult = SampleRMQR(*binImg, fp);
+			auto detectorResult = SampleRMQR(images(fp.isInverted), fp);
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if (decoderResult.isValid(_opts.returnErrors())) {
 					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::RMQRCode);
+					SetIsInverted(res.back(), fp.isInverted);
 					if (maxSymbols && Size(res) == maxSymbols)
 						break;
 				}
@@ -17,6 +17,7 @@ public:
 
 	Barcode decode(const BinaryBitmap& image) const override;
 	Barcodes decode(const BinaryBitmap& image, int maxSymbols) const override;
+	bool findsInverted() const override { return _opts.tryInvert(); }
 };
 
 } // namespace ZXing::QRCode
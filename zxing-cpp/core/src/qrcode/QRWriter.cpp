@@ -26,11 +26,16 @@ Writer::Writer()
 	  _encoding(CharacterSet::Unknown),
 	  _version(0),
 	  _useGs1Format(false),
-	  _maskPattern(-1)
+	  _maskPattern(-1),
+	  _compact(false)
 {}
 
 BitMatrix Writer::encode(const std::wstring& contents, int width, int height) const
 {
+	if (_compact) {
+		return encode(ToUtf8(contents), width, height);
+	}
+
 	if (contents.empty()) {
 		throw std::invalid_argument("Found empty contents");
 	}
@@ -45,7 +50,20 @@ BitMatrix Writer::encode(const std::wstring& contents, int width, int height) co
 
 BitMatrix Writer::encode(const std::string& contents, int width, int height) const
 {
-	return encode(FromUtf8(contents), width, height);
+	if (!_compact) {
+		return encode(FromUtf8(contents), width, height);
+	}
+
+	if (contents.empty()) {
+		throw std::invalid_argument("Found empty contents");
+	}
+
+	if (width < 0 || height < 0) {
+		throw std::invalid_argument("Requested dimensions are invalid");
+	}
+
+	EncodeResult code = EncodeCompact(contents, _ecLevel, _encoding, _version, _useGs1Format, _maskPattern);
+	return Inflate(std::move(code.matrix), width, height, _margin);
 }
 
 } // namespace ZXing::QRCode
@@ -58,6 +58,15 @@ public:
 		return *this;
 	}
 
+	/**
+	* Split the content into Numeric, Alphanumeric, Byte and Kanji segments to encode it in the least number of bits
+	* instead of using a single mode for all of it.
+	*/
+	Writer& setCompact(bool compact) {
+		_compact = compact;
+		return *this;
+	}
+
 	BitMatrix encode(const std::wstring& contents, int width, int height) const;
 	BitMatrix encode(const std::string& contents, int width, int height) const;
 
@@ -68,6 +77,7 @@ private:
 	int _version;
 	bool _useGs1Format;
 	int _maskPattern;
+	bool _compact;
 };
 
 } // QRCode
@@ -0,0 +1,122 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the throughput of the concentric finder pattern code (LocateConcentricPattern and FindConcentricPatternCorners)
+// on the QR Code and Aztec sample sets. The candidates are collected once per image by a simple row scan, so only the
+// ring tracing and square fitting is timed.
+
+#include "BitMatrix.h"
+#include "ConcentricFinder.h"
+#include "HybridBinarizer.h"
+#include "ImageLoader.h"
+#include "Pattern.h"
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::Test;
+
+struct Candidate
+{
+	PointF p;
+	int range;
+};
+
+struct Stats
+{
+	long candidates = 0, patterns = 0, corners = 0;
+	std::chrono::duration<double> time = {};
+};
+
+template <typename PATTERN>
+static std::vector<Candidate> CollectCandidates(const BitMatrix& image, PATTERN pattern, bool startWithSpace)
+{
+	std::vector<Candidate> res;
+	PatternRow row;
+	for (int y = 0; y < image.height(); ++y) {
+		GetPatternRow(image, y, row, false);
+		PatternView next = row;
+		if (startWithSpace)
+			next.shift(1);
+		while (next = FindLeftGuard(next, 0, pattern, 0), next.isValid()) {
+			PointF p(next.pixelsInFront() + Reduce(next.begin(), next.begin() + Size(pattern) / 2, 0) + next[Size(pattern) / 2] / 2.0,
+					 y + 0.5);
+			res.push_back({p, next.sum() * 3});
+			next.skipPair();
+		}
+	}
+	return res;
+}
+
+template <bool E2E, typename PATTERN>
+static void Run(const fs::path& samples, const std::string& prefix, PATTERN pattern, bool startWithSpace, int ringIndex,
+				int iterations, Stats& stats)
+{
+	std::vector<fs::path> dirs;
+	for (const auto& entry : fs::directory_iterator(samples))
+		if (entry.is_directory() && entry.path().filename().string().rfind(prefix, 0) == 0)
+			dirs.push_back(entry.path());
+	std::sort(dirs.begin(), dirs.end());
+
+	for (const auto& dir : dirs) {
+		for (const auto& entry : fs::directory_iterator(dir)) {
+			if (!Contains({".png", ".jpg", ".pgm", ".gif"}, entry.path().extension()))
+				continue;
+			HybridBinarizer binarizer(ImageLoader::load(entry.path()));
+			auto image = binarizer.getBitMatrix();
+			if (!image)
+				continue;
+			auto candidates = CollectCandidates(*image, pattern, startWithSpace);
+
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < iterations; ++i) {
+				for (const auto& c : candidates) {
+					auto fp = LocateConcentricPattern<E2E>(*image, pattern, c.p, c.range);
+					if (!fp)
+						continue;
+					stats.patterns++;
+					if (FindConcentricPatternCorners(*image, *fp, fp->size, ringIndex))
+						stats.corners++;
+				}
+			}
+			stats.time += std::chrono::steady_clock::now() - start;
+			stats.candidates += iterations * Size(candidates);
+		}
+		ImageLoader::clearCache();
+	}
+}
+
+static void Print(const std::string& name, const Stats& stats)
+{
+	std::cout << name << ": " << stats.candidates << " candidates, " << stats.patterns << " patterns, " << stats.corners
+			  << " corners in " << int(stats.time.count() * 1000) << " ms => "
+			  << long(stats.candidates / std::max(stats.time.count(), 1e-9)) << " candidates/s\n";
+}
+
+int main(int argc, char** argv)
+{
+	if (argc <= 1) {
+		std::cout << "Usage: " << argv[0] << " <samples_path> [iterations]" << std::endl;
+		return 0;
+	}
+
+	fs::path samples = argv[1];
+	int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+	Stats qr, aztec;
+	Run<true>(samples, "qrcode-", FixedPattern<5, 7>{1, 1, 3, 1, 1}, false, 2, iterations, qr);
+	Run<false>(samples, "aztec-", FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1}, true, 3, iterations, aztec);
+
+	Print("QRCode", qr);
+	Print("Aztec ", aztec);
+
+	return 0;
+}
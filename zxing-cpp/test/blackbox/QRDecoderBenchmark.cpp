@@ -0,0 +1,86 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures the throughput of QRCode::Decode() on the QR Code sample set. The symbols are detected and sampled once per
+// image, so only the decoding of the sampled bit matrices (reading the codewords, error correction and parsing the bit
+// stream) is timed.
+
+#include "BitMatrix.h"
+#include "ConcentricFinder.h"
+#include "DecoderResult.h"
+#include "HybridBinarizer.h"
+#include "ImageLoader.h"
+#include "ZXAlgorithms.h"
+#include "qrcode/QRDecoder.h"
+#include "qrcode/QRDetector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::Test;
+
+static std::vector<BitMatrix> CollectSymbols(const fs::path& samples)
+{
+	std::vector<fs::path> dirs;
+	for (const auto& entry : fs::directory_iterator(samples))
+		if (entry.is_directory() && entry.path().filename().string().rfind("qrcode-", 0) == 0)
+			dirs.push_back(entry.path());
+	std::sort(dirs.begin(), dirs.end());
+
+	std::vector<BitMatrix> res;
+	for (const auto& dir : dirs) {
+		for (const auto& entry : fs::directory_iterator(dir)) {
+			if (!Contains({".png", ".jpg", ".pgm", ".gif"}, entry.path().extension()))
+				continue;
+			HybridBinarizer binarizer(ImageLoader::load(entry.path()));
+			auto image = binarizer.getBitMatrix();
+			if (!image)
+				continue;
+			DualPolarityBitMatrix images(*image, false);
+			auto fps = QRCode::FindFinderPatterns(images, true);
+			for (const auto& fpSet : QRCode::GenerateFinderPatternSets(fps)) {
+				auto detectorResult = QRCode::SampleQR(*image, fpSet);
+				if (detectorResult.isValid() && QRCode::Decode(detectorResult.bits()).isValid())
+					res.push_back(detectorResult.bits().copy());
+			}
+		}
+		ImageLoader::clearCache();
+	}
+	return res;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc <= 1) {
+		std::cout << "Usage: " << argv[0] << " <samples_path> [iterations]" << std::endl;
+		return 0;
+	}
+
+	int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100;
+	auto symbols = CollectSymbols(argv[1]);
+
+	int numModules = 0;
+	for (const auto& bits : symbols)
+		numModules += bits.width() * bits.height();
+
+	long numValid = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		for (const auto& bits : symbols)
+			numValid += QRCode::Decode(bits).isValid();
+	std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+	long numDecodes = long(iterations) * Size(symbols);
+	std::cout << "QRCode: " << Size(symbols) << " symbols (" << numModules / std::max(Size(symbols), 1) << " modules on average), "
+			  << numDecodes << " decodes (" << numValid << " valid) in " << int(time.count() * 1000) << " ms => "
+			  << long(numDecodes / std::max(time.count(), 1e-9)) << " decodes/s\n";
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 ZXing authors
+ */
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "oned/ODDataBarExpandedReader.h"
+
+#include <cstdlib>
+
+using namespace ZXing;
+using namespace ZXing::OneD;
+
+// Builds a map of pairs from the input, e.g. a lot of pairs for the same finders with checksums that almost add up, and
+// runs FindValidSequence() on it. The input is limited to MAX_PAIRS pairs, so the work per run is bounded by the input
+// size and a search that is not linear in it shows up as a libFuzzer timeout (-timeout) instead of a flaky wall-clock
+// check.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	constexpr size_t MAX_PAIRS = 1024;
+	if (size < 4 || size > 4 * MAX_PAIRS)
+		return 0;
+
+	DataBar::PairMap all;
+	for (size_t i = 0; i + 4 <= size; i += 4) {
+		DataBar::Pair p;
+		p.finder = (data[i] % 6 + 1) * (data[i] & 0x40 ? -1 : 1);
+		p.left = {((data[i] >> 7) << 11) | (data[i + 1] << 3) | (data[i + 2] & 0x7), data[i + 2] >> 3};
+		// the left character of a FINDER_A pair is the checksum character, which encodes one of the 10 finder sequences
+		if (p.finder == 1)
+			p.left.value %= 19 * 211;
+		if (data[i + 3] & 1)
+			p.right = {data[i + 3] << 2, data[i + 3] >> 1};
+		all[p.finder].push_back(p);
+	}
+
+	auto pairs = DataBar::FindValidSequence(all);
+
+	if (!pairs.empty() && pairs.front().finder != 1)
+		abort();
+
+	return 0;
+}
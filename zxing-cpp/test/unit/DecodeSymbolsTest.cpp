@@ -0,0 +1,102 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "Matrix.h"
+#include "ReadBarcode.h"
+#include "datamatrix/DMWriter.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+
+#ifdef ZXING_EXPERIMENTAL_API
+
+// module grids with dark modules = 0, the same as Barcode::symbol()
+static std::vector<Matrix<uint8_t>> ModuleGrids(const std::vector<BitMatrix>& symbols)
+{
+	std::vector<Matrix<uint8_t>> res;
+	for (auto& bits : symbols)
+		res.push_back(ToMatrix<uint8_t>(bits));
+	return res;
+}
+
+static std::vector<ImageView> Views(const std::vector<Matrix<uint8_t>>& grids)
+{
+	std::vector<ImageView> res;
+	for (auto& grid : grids)
+		res.emplace_back(grid.data(), grid.width(), grid.height(), ImageFormat::Lum);
+	return res;
+}
+
+TEST(DecodeSymbolsTest, QRCode)
+{
+	std::vector<BitMatrix> symbols;
+	for (int i = 0; i < 20; ++i)
+		symbols.push_back(QRCode::Writer().setMargin(0).encode("SYMBOL-" + std::to_string(i), 0, 0));
+
+	// the bottom right module is part of the first data codeword
+	auto& damaged = symbols[3];
+	damaged.flip(damaged.width() - 1, damaged.height() - 1);
+
+	auto grids = ModuleGrids(symbols);
+	auto views = Views(grids);
+
+	std::vector<ErrorCorrectionStats> stats;
+	auto res = DecodeSymbols(views, BarcodeFormat::QRCode, {}, &stats);
+	ASSERT_EQ(res.size(), symbols.size());
+	ASSERT_EQ(stats.size(), symbols.size());
+	for (int i = 0; i < Size(res); ++i) {
+		EXPECT_TRUE(res[i].isValid());
+		EXPECT_EQ(res[i].format(), BarcodeFormat::QRCode);
+		EXPECT_EQ(res[i].text(), "SYMBOL-" + std::to_string(i));
+		EXPECT_EQ(res[i].symbol().width(), symbols[i].width());
+		EXPECT_GT(stats[i].ecCodewords, 0);
+		EXPECT_EQ(stats[i].errorsCorrected, i == 3 ? 1 : 0);
+	}
+
+	for (int maxThreads : {0, 3}) {
+		auto parallel = DecodeSymbols(views, BarcodeFormat::QRCode, ReaderOptions().setMaxThreads(maxThreads));
+		ASSERT_EQ(parallel.size(), res.size());
+		for (int i = 0; i < Size(res); ++i)
+			EXPECT_EQ(parallel[i].text(), res[i].text());
+	}
+}
+
+TEST(DecodeSymbolsTest, DataMatrix)
+{
+	std::vector<BitMatrix> symbols;
+	symbols.push_back(DataMatrix::Writer().setMargin(0).encode("DataMatrix", 0, 0));
+	symbols.push_back(symbols.back().copy());
+	// the top left module inside the finder pattern is part of a codeword
+	symbols.back().flip(1, 1);
+	// no symbol at all
+	symbols.push_back(BitMatrix(symbols.back().width(), symbols.back().height()));
+
+	auto grids = ModuleGrids(symbols);
+	std::vector<ErrorCorrectionStats> stats;
+	auto res = DecodeSymbols(Views(grids), BarcodeFormat::DataMatrix, {}, &stats);
+	ASSERT_EQ(res.size(), 3);
+
+	EXPECT_EQ(res[0].text(), "DataMatrix");
+	EXPECT_EQ(res[0].format(), BarcodeFormat::DataMatrix);
+	EXPECT_EQ(stats[0].errorsCorrected, 0);
+	EXPECT_EQ(res[1].text(), "DataMatrix");
+	EXPECT_EQ(stats[1].errorsCorrected, 1);
+	EXPECT_EQ(stats[1].ecCodewords, stats[0].ecCodewords);
+	EXPECT_FALSE(res[2].isValid());
+}
+
+TEST(DecodeSymbolsTest, UnsupportedFormat)
+{
+	EXPECT_THROW(DecodeSymbols({}, BarcodeFormat::Aztec), std::invalid_argument);
+}
+
+#endif
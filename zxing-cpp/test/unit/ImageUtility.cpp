@@ -0,0 +1,21 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ImageUtility.h"
+#include "BitMatrix.h"
+
+namespace ZXing { namespace Utility {
+
+void DrawSymbol(std::vector<uint8_t>& pixels, int width, const BitMatrix& bits, int left, int top, int scale, int height,
+				bool inverted)
+{
+	if (height <= 0)
+		height = bits.height() * scale;
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < bits.width() * scale; ++x)
+			pixels[(top + y) * width + left + x] = bits.get(x / scale, y * bits.height() / height) != inverted ? 0 : 0xff;
+}
+
+}} // namespace ZXing::Utility
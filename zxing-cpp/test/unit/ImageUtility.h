@@ -0,0 +1,23 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ZXing {
+
+class BitMatrix;
+
+namespace Utility {
+
+	// Draws bits into the 8-bit grayscale image pixels of the given width with its top left corner at (left, top),
+	// scale pixels per module, black modules as 0 and white ones as 0xff (the other way round if inverted). The rows
+	// of bits are stretched to height pixels, e.g. to draw a linear symbol (a single row) with a given bar height.
+	void DrawSymbol(std::vector<uint8_t>& pixels, int width, const BitMatrix& bits, int left, int top, int scale,
+					int height = 0, bool inverted = false);
+
+}} // ZXing::Utility
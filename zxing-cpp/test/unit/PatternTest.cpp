@@ -64,3 +64,19 @@ TEST(PatternTest, WhiteBlack)
 		EXPECT_EQ(pr[2], 0);
 	}
 }
+
+TEST(PatternTest, PatternIndex)
+{
+	static constexpr int keys[] = {0x114, 0x148, 0x144, 0x142, 0x128, 0x15E, 7, 1 << 30};
+	static constexpr auto index = PatternIndex<8>(keys);
+	static_assert(index.isValid());
+	static_assert(index.indexOf(0x144) == 2);
+
+	for (int i = 0; i < 8; ++i)
+		EXPECT_EQ(index.indexOf(keys[i]), i);
+	for (int key : {0, 1, 0x115, 0x1ff, -1, 1 << 29})
+		EXPECT_EQ(index.indexOf(key), -1);
+
+	static constexpr int duplicates[] = {3, 5, 3};
+	static_assert(!PatternIndex<3>(duplicates).isValid());
+}
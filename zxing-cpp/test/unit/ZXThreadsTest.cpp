@@ -0,0 +1,32 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ZXAlgorithms.h"
+#include "ZXThreads.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace ZXing;
+
+TEST(ZXThreadsTest, RunOnThreads)
+{
+	std::vector<int> ran(4);
+	RunOnThreads(Size(ran), [&](int t) { ran[t] = t + 1; });
+	EXPECT_EQ(ran, std::vector<int>({1, 2, 3, 4}));
+
+	// an exception of a worker is rethrown on the calling thread after all of them are done
+	std::fill(ran.begin(), ran.end(), 0);
+	EXPECT_THROW(RunOnThreads(Size(ran),
+							  [&](int t) {
+								  ran[t] = 1;
+								  if (t == 2)
+									  throw std::runtime_error("worker");
+							  }),
+				 std::runtime_error);
+	EXPECT_EQ(ran, std::vector<int>({1, 1, 1, 1}));
+}
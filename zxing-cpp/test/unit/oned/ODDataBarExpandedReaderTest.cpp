@@ -0,0 +1,58 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "oned/ODDataBarExpandedReader.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::OneD;
+using namespace ZXing::OneD::DataBar;
+
+static Pair MakePair(int finder, Character left, Character right = {})
+{
+	Pair res;
+	res.finder = finder;
+	res.left = left;
+	res.right = right;
+	return res;
+}
+
+TEST(ODDataBarExpandedReaderTest, FindValidSequence)
+{
+	// sequence {A, -B, B} with a half-pair at the end: the checksum value is 211 * 1 + (10 + 20 + 30 + 40 + 50) % 211
+	auto a = MakePair(1, {361, 10}, {100, 20});
+	auto b1 = MakePair(-2, {200, 30}, {300, 40});
+	auto b2 = MakePair(2, {400, 50});
+
+	PairMap all;
+	all[1] = {a};
+	all[-2] = {MakePair(-2, {201, 31}, {301, 41}), b1}; // the more common one does not add up
+	EXPECT_TRUE(FindValidSequence(all).empty());
+
+	all[2] = {MakePair(2, {401, 50}, {500, 0}), b2}; // a full pair has the right checksum but needs to be a half-pair
+	auto res = FindValidSequence(all);
+	ASSERT_EQ(res.size(), 3);
+	EXPECT_EQ(res[0], a);
+	EXPECT_EQ(res[1], b1);
+	EXPECT_EQ(res[2], b2);
+
+	// only the 2 most common pairs of each finder are considered
+	all[-2].insert(all[-2].begin(), MakePair(-2, {202, 32}, {302, 42}));
+	EXPECT_TRUE(FindValidSequence(all).empty());
+}
+
+TEST(ODDataBarExpandedReaderTest, FindValidSequenceIgnoresInvalidChecksumCharacters)
+{
+	// a checksum character (the left one of a FINDER_A pair) beyond the 10 finder sequences, with pairs for all finders
+	PairMap all;
+	all[1] = {MakePair(1, {4095, 0}, {0, 0})};
+	for (int finder = 1; finder <= 6; ++finder) {
+		all[-finder].push_back(MakePair(-finder, {0, 0}, {0, 0}));
+		if (finder > 1)
+			all[finder].push_back(MakePair(finder, {0, 0}, {0, 0}));
+	}
+	EXPECT_TRUE(FindValidSequence(all).empty());
+}
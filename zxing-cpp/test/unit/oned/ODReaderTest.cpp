@@ -0,0 +1,195 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ImageUtility.h"
+#include "ReadBarcode.h"
+#include "oned/ODCode128Writer.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::OneD;
+using namespace ZXing::Utility;
+
+#ifdef ZXING_EXPERIMENTAL_API
+
+TEST(ODReaderTest, ParallelRowScanIsDeterministic)
+{
+	const int width = 400, height = 1000;
+	std::vector<uint8_t> pixels(width * height, 0xff);
+
+	auto paint = [&](const std::string& text, int left, int top, int rows) {
+		DrawSymbol(pixels, width, Code128Writer().setMargin(0).encode(text, 0, 1), left, top, 2, rows);
+	};
+	paint("first", 40, 120, 60);
+	paint("second", 60, 480, 30);
+	paint("third", 30, 820, 100);
+
+	auto read = [&](int maxThreads) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryRotate(false).setMaxThreads(maxThreads);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	auto expected = read(1);
+	ASSERT_EQ(expected.size(), 3);
+
+	for (int maxThreads : {0, 2, 3, 8}) {
+		auto res = read(maxThreads);
+		ASSERT_EQ(res.size(), expected.size());
+		for (size_t i = 0; i < res.size(); ++i) {
+			EXPECT_EQ(res[i].text(), expected[i].text());
+			EXPECT_EQ(res[i].position(), expected[i].position());
+			EXPECT_EQ(res[i].lineCount(), expected[i].lineCount());
+		}
+	}
+}
+
+TEST(ODReaderTest, AdaptiveRowScanFindsSymbolOutsideCenter)
+{
+	const int width = 400, height = 1000;
+	std::vector<uint8_t> pixels(width * height, 0xff);
+
+	// a symbol near the top, outside of the rows scanned without tryHarder
+	DrawSymbol(pixels, width, Code128Writer().setMargin(0).encode("top", 0, 1), 50, 60, 2, 50);
+
+	auto read = [&](bool adaptive) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryHarder(false).setTryRotate(false).setAdaptiveRowScan(adaptive);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	EXPECT_TRUE(read(false).empty());
+
+	auto res = read(true);
+	ASSERT_EQ(res.size(), 1);
+	EXPECT_EQ(res[0].text(), "top");
+	EXPECT_GE(res[0].lineCount(), 2);
+	EXPECT_GE(res[0].position().topLeft().y, 60);
+	EXPECT_LT(res[0].position().bottomLeft().y, 110);
+}
+
+TEST(ODReaderTest, ScanLinesAtAnAngle)
+{
+	const int width = 600, height = 600;
+	std::vector<uint8_t> pixels(width * height, 0xff);
+
+	// a symbol rotated by 40 degrees around the center of the image with 4 pixels per module and 100 pixels high
+	auto bits = Code128Writer().setMargin(0).encode("skewed", 0, 1);
+	const double a = 40 * 3.14159265358979323846 / 180;
+	const PointF center(width / 2, height / 2);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x) {
+			auto d = PointF(x, y) - center;
+			int module = int(std::floor((d.x * std::cos(a) + d.y * std::sin(a)) / 4 + bits.width() / 2.));
+			double v = -d.x * std::sin(a) + d.y * std::cos(a);
+			if (module >= 0 && module < bits.width() && std::abs(v) < 50 && bits.get(module, 0))
+				pixels[y * width + x] = 0;
+		}
+
+	auto read = [&](int directions) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryHarder(false).setScanLineDirections(directions);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	EXPECT_TRUE(read(0).empty());
+
+	auto res = read(8);
+	ASSERT_EQ(res.size(), 1);
+	EXPECT_EQ(res[0].text(), "skewed");
+	// the position is in image coordinates
+	EXPECT_LT(distance(PointF(Center(res[0].position())), center), 20);
+	EXPECT_NEAR(res[0].orientation(), 45, 10);
+}
+
+TEST(ODReaderTest, SubPixelRowsReadSmallSymbols)
+{
+	// a symbol with 1.3 pixels per module, each pixel the average of the modules it covers
+	auto bits = Code128Writer().setMargin(0).encode("tiny", 0, 1);
+	const double moduleSize = 1.3, left = 20.3;
+	const int width = int(bits.width() * moduleSize) + 40, height = 20;
+	std::vector<uint8_t> pixels(width * height);
+	for (int x = 0; x < width; ++x) {
+		double coverage = 0;
+		for (int s = 0; s < 16; ++s) {
+			int module = int(std::floor((x + (s + 0.5) / 16 - left) / moduleSize));
+			coverage += (module >= 0 && module < bits.width() && bits.get(module, 0)) / 16.;
+		}
+		for (int y = 0; y < height; ++y)
+			pixels[y * width + x] = uint8_t(40 + 180 * (1 - coverage));
+	}
+
+	auto read = [&](bool subPixel) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryRotate(false).setTryDownscale(false).setSubPixelRows(subPixel);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	EXPECT_TRUE(read(false).empty());
+
+	auto res = read(true);
+	ASSERT_EQ(res.size(), 1);
+	EXPECT_EQ(res[0].text(), "tiny");
+	// the position is in pixels
+	EXPECT_NEAR(res[0].position().topLeft().x, left, 2);
+	EXPECT_NEAR(res[0].position().topRight().x, left + bits.width() * moduleSize, 2);
+}
+
+TEST(ODReaderTest, SubPixelRowsWiderThanTheirFixedPointRange)
+{
+	// an upside down symbol on a line that is wider than 8191 pixels, i.e. wider than 16 bits in sub-pixel units (the
+	// widths of the single bars and spaces still fit)
+	const int width = 9000, height = 20, left = 4000;
+	auto bits = Code128Writer().setMargin(0).encode("wide", 0, 1);
+	bits.rotate180();
+	std::vector<uint8_t> pixels(width * height, 0xff);
+	DrawSymbol(pixels, width, bits, left, 0, 2, height);
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryRotate(false).setTryDownscale(false).setSubPixelRows(true);
+	auto res = ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	ASSERT_EQ(res.size(), 1);
+	EXPECT_EQ(res[0].text(), "wide");
+	EXPECT_NEAR(Center(res[0].position()).x, left + bits.width(), 4);
+}
+
+TEST(ODReaderTest, LineScanReaderReportsEachSymbolOnce)
+{
+	const int width = 400;
+	std::vector<uint8_t> symbolRow(width, 0xff), emptyRow(width, 0xff);
+	DrawSymbol(symbolRow, width, Code128Writer().setMargin(0).encode("stream", 0, 1), 40, 0, 2, 1);
+
+	LineScanReader reader(ReaderOptions().setFormats(BarcodeFormat::Code128).setMinLineCount(3), 64);
+	std::vector<std::pair<int, Barcode>> found;
+	auto add = [&](const std::vector<uint8_t>& row, int count) {
+		for (int i = 0; i < count; ++i)
+			for (auto& barcode : reader.addRows(ImageView(row.data(), width, 1, ImageFormat::Lum)))
+				found.emplace_back(reader.rowCount() - 1, std::move(barcode));
+	};
+
+	add(emptyRow, 50);
+	add(symbolRow, 30);
+	add(emptyRow, 100);
+	EXPECT_EQ(reader.rowCount(), 180);
+
+	// reported on the third row of the symbol
+	ASSERT_EQ(found.size(), 1);
+	EXPECT_EQ(found[0].first, 52);
+	EXPECT_EQ(found[0].second.text(), "stream");
+	EXPECT_EQ(found[0].second.lineCount(), 3);
+	EXPECT_EQ(found[0].second.position().topLeft().y, 50);
+	EXPECT_EQ(found[0].second.position().bottomLeft().y, 52);
+
+	// a second symbol with the same content in the stream
+	add(symbolRow, 10);
+	ASSERT_EQ(found.size(), 2);
+	EXPECT_EQ(found[1].first, 182);
+	EXPECT_EQ(found[1].second.position().topLeft().y, 180);
+
+	reader.reset();
+	EXPECT_EQ(reader.rowCount(), 0);
+}
+
+#endif
@@ -14,7 +14,7 @@
 
 namespace ZXing {
 	namespace QRCode {
-		DecoderResult DecodeBitStream(ByteArray&& bytes, const Version& version, ErrorCorrectionLevel ecLevel);
+		DecoderResult DecodeBitStream(const ByteArray& bytes, const Version& version, ErrorCorrectionLevel ecLevel);
 	}
 }
 
@@ -0,0 +1,139 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ImageUtility.h"
+#include "ReadBarcode.h"
+#include "qrcode/QRDetector.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::Utility;
+
+// a sheet of equally sized symbols in a regular grid with little space in between, where finder patterns of neighboring
+// symbols form better right isosceles triangles than the ones of the same symbol
+static std::vector<uint8_t> LabelSheet(int cols, int rows, int& width, int& height)
+{
+	const int scale = 3, gap = 8;
+	std::vector<BitMatrix> symbols;
+	int size = 0;
+	for (int i = 0; i < cols * rows; ++i) {
+		symbols.push_back(QRCode::Writer().setMargin(0).encode("LABEL-" + std::to_string(1000 + i), 0, 0));
+		size = std::max(size, symbols.back().width() * scale);
+	}
+
+	width = cols * (size + gap) + gap, height = rows * (size + gap) + gap;
+	std::vector<uint8_t> pixels(width * height, 0xff);
+	for (int i = 0; i < cols * rows; ++i)
+		DrawSymbol(pixels, width, symbols[i], gap + (i % cols) * (size + gap), gap + (i / cols) * (size + gap), scale);
+	return pixels;
+}
+
+TEST(QRDetectorTest, LabelSheet)
+{
+	const int cols = 8, rows = 8;
+	int width, height;
+	auto pixels = LabelSheet(cols, rows, width, height);
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setTryRotate(false).setTryInvert(false).setTryDownscale(false);
+	auto res = ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+
+	std::set<std::string> texts;
+	for (auto& barcode : res)
+		texts.insert(barcode.text());
+	EXPECT_EQ(Size(texts), cols * rows);
+}
+
+#ifdef ZXING_EXPERIMENTAL_API
+
+TEST(QRDetectorTest, ParallelFinderPatternSearchIsDeterministic)
+{
+	int width, height;
+	auto pixels = LabelSheet(6, 10, width, height);
+
+	auto read = [&](int maxThreads) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setTryRotate(false).setTryDownscale(false).setMaxThreads(maxThreads);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	auto expected = read(1);
+	ASSERT_EQ(expected.size(), 60);
+
+	for (int maxThreads : {0, 2, 3, 8}) {
+		auto res = read(maxThreads);
+		ASSERT_EQ(res.size(), expected.size());
+		for (size_t i = 0; i < res.size(); ++i) {
+			EXPECT_EQ(res[i].text(), expected[i].text());
+			EXPECT_EQ(res[i].position(), expected[i].position());
+		}
+	}
+}
+
+#endif
+
+TEST(QRDetectorTest, MixedPolarities)
+{
+	// a normal and an inverted symbol (each with a quiet zone of 4 modules) side by side on a gray background
+	const int scale = 4, quietZone = 4 * scale;
+	auto normal = QRCode::Writer().setMargin(4).encode("normal", 0, 0);
+	auto inverted = QRCode::Writer().setMargin(4).encode("inverted", 0, 0);
+	const int size = std::max(normal.width(), inverted.width()) * scale;
+	const int width = 2 * size + 3 * quietZone, height = size + 2 * quietZone;
+	std::vector<uint8_t> pixels(width * height, 0x80);
+
+	DrawSymbol(pixels, width, normal, quietZone, quietZone, scale);
+	DrawSymbol(pixels, width, inverted, size + 2 * quietZone, quietZone, scale, 0, true);
+
+	auto read = [&](bool tryInvert) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setTryRotate(false).setTryDownscale(false).setTryInvert(tryInvert);
+		return ReadBarcodes(ImageView(pixels.data(), width, height, ImageFormat::Lum), opts);
+	};
+
+	auto res = read(false);
+	ASSERT_EQ(res.size(), 1);
+	EXPECT_EQ(res[0].text(), "normal");
+	EXPECT_FALSE(res[0].isInverted());
+
+	res = read(true);
+	ASSERT_EQ(res.size(), 2);
+	EXPECT_EQ(res[0].text(), "normal");
+	EXPECT_FALSE(res[0].isInverted());
+	EXPECT_EQ(res[1].text(), "inverted");
+	EXPECT_TRUE(res[1].isInverted());
+}
+
+TEST(QRDetectorTest, SingleFinderPatternCandidate)
+{
+	// a finder pattern in the middle of a checkerboard of modules (like inside of a symbol) or with a quiet zone on the
+	// left and on top (like the one of a Micro QR Code)
+	const int scale = 3;
+	auto image = [&](bool quietZone) {
+		BitMatrix res(40 * scale, 40 * scale);
+		for (int y = 0; y < 40; ++y)
+			for (int x = 0; x < 40; ++x) {
+				// the finder pattern covers the modules 16..22 in both directions, surrounded by the separator
+				int ring = std::max(std::abs(x - 19), std::abs(y - 19));
+				bool black = ring <= 3 ? ring != 2 : ring > 4 && (x + y) % 2 == 0 && !(quietZone && (x < 16 || y < 16));
+				if (black)
+					res.setRegion(x * scale, y * scale, scale, scale);
+			}
+		return res;
+	};
+
+	ConcentricPattern fp;
+	fp.x = fp.y = 19.5 * scale;
+	fp.size = 7 * scale;
+
+	EXPECT_FALSE(QRCode::IsSingleFinderPatternCandidate(image(false), fp));
+	EXPECT_TRUE(QRCode::IsSingleFinderPatternCandidate(image(true), fp));
+}
@@ -7,10 +7,16 @@
 #include "BitArrayUtility.h"
 #include "BitMatrixIO.h"
 #include "CharacterSet.h"
+#include "DecoderResult.h"
 #include "TextDecoder.h"
 #include "Utf.h"
+#ifdef ZXING_EXPERIMENTAL_API
+#include "MultiFormatWriter.h"
+#include "WriteBarcode.h"
+#endif
 #include "qrcode/QREncoder.h"
 #include "qrcode/QRCodecMode.h"
+#include "qrcode/QRDecoder.h"
 #include "qrcode/QREncodeResult.h"
 #include "qrcode/QRErrorCorrectionLevel.h"
 
@@ -352,6 +358,71 @@ TEST(QREncoderTest, EncodeGS1ModeHeaderWithECI)
 		"X X X X X X X     X X X   X X   X     X   \n");
 }
 
+TEST(QREncoderTest, EncodeCompact)
+{
+	auto decode = [](const EncodeResult& qrCode) { return Decode(qrCode.matrix).content().utf8(); };
+
+	// an alphanumeric prefix, a numeric serial and a lowercase suffix need a Byte segment only for the suffix
+	std::string text = "SN-ABC/20250612000123456789xyz";
+	auto single = Encode(FromUtf8(text), ErrorCorrectionLevel::Medium, CharacterSet::Unknown, 0, false, -1);
+	auto compact = EncodeCompact(text, ErrorCorrectionLevel::Medium, CharacterSet::Unknown, 0, false, -1);
+	EXPECT_EQ(single.version->versionNumber(), 3);
+	EXPECT_EQ(compact.version->versionNumber(), 2);
+	EXPECT_EQ(compact.mode, CodecMode::ALPHANUMERIC);
+	EXPECT_EQ(decode(compact), text);
+
+	// content that is best encoded in a single mode gives the same symbol
+	for (auto str : {L"0123456789012", L"ABCDEF", L"hello"}) {
+		auto expected = Encode(str, ErrorCorrectionLevel::High, CharacterSet::Unknown, 0, false, -1);
+		auto actual = EncodeCompact(ToUtf8(str), ErrorCorrectionLevel::High, CharacterSet::Unknown, 0, false, -1);
+		EXPECT_EQ(actual.mode, expected.mode);
+		EXPECT_EQ(actual.matrix, expected.matrix) << ToUtf8(str);
+	}
+
+	// the ECI designator is only written if there is a Byte segment
+	text = "Grüße 0123456789012345";
+	EXPECT_EQ(decode(EncodeCompact(text, ErrorCorrectionLevel::Low, CharacterSet::UTF8, 0, false, -1)), text);
+	text = "0123456789";
+	EXPECT_EQ(EncodeCompact(text, ErrorCorrectionLevel::Low, CharacterSet::UTF8, 0, false, -1).matrix,
+			  Encode(FromUtf8(text), ErrorCorrectionLevel::Low, CharacterSet::Unknown, 0, false, -1).matrix);
+
+	// Kanji segments only without ECI or with Shift_JIS
+	text = "\u65e5\u672c 1234567890";
+	for (auto charset : {CharacterSet::Unknown, CharacterSet::Shift_JIS, CharacterSet::UTF8})
+		EXPECT_EQ(decode(EncodeCompact(text, ErrorCorrectionLevel::Low, charset, 0, false, -1)), text) << ToString(charset);
+	EXPECT_EQ(EncodeCompact(text, ErrorCorrectionLevel::Low, CharacterSet::Unknown, 0, false, -1).mode, CodecMode::KANJI);
+
+	// a '%' in an alphanumeric segment would be a GS character in FNC1 mode
+	text = "10ABC%11171218";
+	EXPECT_EQ(Decode(EncodeCompact(text, ErrorCorrectionLevel::High, CharacterSet::Unknown, 0, true, -1).matrix).content().text(TextMode::Plain),
+			  text);
+
+	EXPECT_EQ(EncodeCompact("ABCDEF", ErrorCorrectionLevel::High, CharacterSet::Unknown, 7, false, -1).version->versionNumber(), 7);
+	EXPECT_THROW(EncodeCompact("THISMESSAGEISTOOLONGFORAQRCODEVERSION3", ErrorCorrectionLevel::High, CharacterSet::Unknown, 3, false, -1),
+				 std::invalid_argument);
+}
+
+#ifdef ZXING_EXPERIMENTAL_API
+TEST(QREncoderTest, CreateBarcodeFromTextIsCompactOnlyIfRequested)
+{
+	std::string text = "SN-ABC/20250612000123456789xyz";
+	auto create = [&](bool compact) {
+		return CreateBarcodeFromText(text, CreatorOptions(BarcodeFormat::QRCode).ecLevel("4").compact(compact));
+	};
+
+	// the default is the single mode symbol of the MultiFormatWriter
+	auto expected = MultiFormatWriter(BarcodeFormat::QRCode).setMargin(0).setEccLevel(4).setEncoding(CharacterSet::UTF8).encode(text, 0, 0);
+	auto single = create(false);
+	EXPECT_EQ(single.text(), text);
+	EXPECT_EQ(single.symbol().width(), expected.width());
+	EXPECT_EQ(CreateBarcodeFromText(text, CreatorOptions(BarcodeFormat::QRCode).ecLevel("4")).symbol().width(), expected.width());
+
+	auto compact = create(true);
+	EXPECT_EQ(compact.text(), text);
+	EXPECT_LT(compact.symbol().width(), single.symbol().width());
+}
+#endif
+
 TEST(QREncoderTest, AppendModeInfo)
 {
 	BitArray bits;
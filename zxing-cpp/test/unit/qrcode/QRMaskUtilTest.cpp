@@ -0,0 +1,71 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitArray.h"
+#include "PseudoRandom.h"
+#include "qrcode/QRErrorCorrectionLevel.h"
+#include "qrcode/QRMaskUtil.h"
+#include "qrcode/QRMatrixUtil.h"
+#include "qrcode/QRVersion.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+static void ExpectSameMatrix(const MaskUtil::PackedMatrix& packed, const TritMatrix& matrix)
+{
+	ASSERT_EQ(packed.width(), matrix.width());
+	ASSERT_EQ(packed.height(), matrix.height());
+	for (int y = 0; y < matrix.height(); ++y)
+		for (int x = 0; x < matrix.width(); ++x)
+			ASSERT_EQ(packed.get(x, y), bool(matrix.get(x, y))) << "at " << x << "," << y;
+}
+
+TEST(QRMaskUtilTest, PackedMatricesMatchBuildMatrix)
+{
+	PseudoRandom random(42);
+	for (int versionNumber = 1; versionNumber <= 40; ++versionNumber) {
+		const Version& version = *Version::Model2(versionNumber);
+		auto ecLevel = ErrorCorrectionLevel(versionNumber % 4);
+		BitArray dataBits;
+		for (int i = 0; i < version.totalCodewords(); ++i)
+			dataBits.appendBits(random.next(0, 255), 8);
+
+		auto matrices = BuildMatrices(dataBits, ecLevel, version);
+		for (int maskPattern = 0; maskPattern < NUM_MASK_PATTERNS; ++maskPattern) {
+			TritMatrix matrix(version.dimension(), version.dimension());
+			BuildMatrix(dataBits, ecLevel, version, maskPattern, matrix);
+			ExpectSameMatrix(matrices[maskPattern], matrix);
+			EXPECT_EQ(MaskUtil::CalculateMaskPenalty(matrices[maskPattern]), MaskUtil::CalculateMaskPenalty(matrix))
+				<< "version " << versionNumber << ", mask " << maskPattern;
+		}
+	}
+}
+
+TEST(QRMaskUtilTest, PackedPenaltyAcrossWordBoundaries)
+{
+	// 1:1:3:1:1 patterns and runs crossing the word boundaries of the packed rows in both directions
+	TritMatrix matrix(177, 177);
+	for (int y = 0; y < 177; ++y)
+		for (int x = 0; x < 177; ++x)
+			matrix.set(x, y, (x + y) % 2);
+	for (int i = 0; i < 7; ++i) {
+		matrix.set(60 + i, 100, i != 1 && i != 5);
+		matrix.set(130, 60 + i, i != 1 && i != 5);
+		matrix.set(125 + i, 20, true);
+	}
+	for (int i = 1; i <= 4; ++i) {
+		matrix.set(60 - i, 100, false);
+		matrix.set(130, 60 - i, false);
+	}
+	EXPECT_EQ(MaskUtil::CalculateMaskPenalty(MaskUtil::PackedMatrix(matrix)), MaskUtil::CalculateMaskPenalty(matrix));
+
+	PseudoRandom random(1);
+	for (int y = 0; y < 177; ++y)
+		for (int x = 0; x < 177; ++x)
+			matrix.set(x, y, random.next(0, 1));
+	EXPECT_EQ(MaskUtil::CalculateMaskPenalty(MaskUtil::PackedMatrix(matrix)), MaskUtil::CalculateMaskPenalty(matrix));
+}
@@ -1,3 +1,33 @@
+# Resolve the ZXING_FORMATS list (ALL or a subset of ZXING_FORMATS_LIST) into one ZXING_ENABLE_<FORMAT> variable
+# per symbology. ZXING_ENABLE_LINEAR is ON if any of the linear symbologies is enabled.
+macro(zxing_enable_formats)
+    set (ZXING_FORMATS_LIST AZTEC CODABAR CODE39 CODE93 CODE128 DATABAR DATAMATRIX DXFILMEDGE EANUPC ITF MAXICODE PDF417 QRCODE)
+    if (NOT DEFINED ZXING_FORMATS OR ZXING_FORMATS STREQUAL "ALL")
+        set (ZXING_FORMATS ${ZXING_FORMATS_LIST})
+    endif()
+    if (NOT ZXING_FORMATS)
+        message (FATAL_ERROR "ZXING_FORMATS must not be empty")
+    endif()
+    foreach (FORMAT ${ZXING_FORMATS})
+        if (NOT FORMAT IN_LIST ZXING_FORMATS_LIST)
+            message (FATAL_ERROR "ZXING_FORMATS must be ALL or a list of ${ZXING_FORMATS_LIST}, unknown format: ${FORMAT}")
+        endif()
+    endforeach()
+    foreach (FORMAT ${ZXING_FORMATS_LIST})
+        if (FORMAT IN_LIST ZXING_FORMATS)
+            set (ZXING_ENABLE_${FORMAT} ON)
+        else()
+            set (ZXING_ENABLE_${FORMAT} OFF)
+        endif()
+    endforeach()
+    set (ZXING_ENABLE_LINEAR OFF)
+    foreach (FORMAT CODABAR CODE39 CODE93 CODE128 DATABAR DXFILMEDGE EANUPC ITF)
+        if (ZXING_ENABLE_${FORMAT})
+            set (ZXING_ENABLE_LINEAR ON)
+        endif()
+    endforeach()
+endmacro()
+
 
 macro(zxing_add_package_stb)
     unset (STB_FOUND CACHE)